@@ -0,0 +1,513 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodClient.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+	using socklen_t = int;
+#else
+	#include <arpa/inet.h>
+	#include <fcntl.h>
+	#include <netdb.h>
+	#include <netinet/in.h>
+	#include <poll.h>
+	#include <sys/socket.h>
+	#include <unistd.h>
+#endif
+
+namespace
+{
+	// 응답 1개 최대 크기 = UDP 최대 페이로드 (HIST 가 붙은 텍스트 OBS 는 15 KB 가까이 됨) + 종료 문자
+	constexpr int32_t RecvBufferBytes = 65507 + 1;
+
+	int64_t NowMs()
+	{
+		using namespace std::chrono;
+		return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	bool IsMasked(const uint8_t* Mask, int32_t Index)
+	{
+		return !Mask || Mask[Index] != 0;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 생성 / 소멸
+// ─────────────────────────────────────────────────────────────────────────────
+
+FHexapodClient::FHexapodClient(const char* Host, int32_t InBasePort, int32_t NumRobots, bool bInQuantized)
+	: BasePort(InBasePort)
+	, bQuantized(bInQuantized)
+{
+	if (NumRobots <= 0) return;
+
+#if defined(_WIN32)
+	WSADATA WsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &WsaData) != 0) return;
+#endif
+
+	addrinfo Hints = {};
+	Hints.ai_family   = AF_INET;
+	Hints.ai_socktype = SOCK_DGRAM;
+	addrinfo* Resolved = nullptr;
+	if (getaddrinfo(Host, nullptr, &Hints, &Resolved) != 0 || !Resolved) return;
+	HostIp = reinterpret_cast<sockaddr_in*>(Resolved->ai_addr)->sin_addr.s_addr;
+	freeaddrinfo(Resolved);
+
+	FSocketHandle S = static_cast<FSocketHandle>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+	if (S == InvalidSocket) return;
+
+	// 로컬 임의 포트에 바인드 → 서버는 이 주소로 응답
+	sockaddr_in Local = {};
+	Local.sin_family      = AF_INET;
+	Local.sin_addr.s_addr = htonl(INADDR_ANY);
+	Local.sin_port        = 0;
+	if (bind(S, reinterpret_cast<sockaddr*>(&Local), sizeof(Local)) != 0)
+	{
+#if defined(_WIN32)
+		closesocket(S);
+#else
+		close(S);
+#endif
+		return;
+	}
+
+	// 로봇이 많으면 응답이 한꺼번에 몰리므로 수신 버퍼를 넉넉히
+	int RecvBuf = 1 << 20;
+	setsockopt(S, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&RecvBuf), sizeof(RecvBuf));
+
+#if defined(_WIN32)
+	u_long NonBlocking = 1;
+	ioctlsocket(S, FIONBIO, &NonBlocking);
+#else
+	fcntl(S, F_SETFL, fcntl(S, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+	Robots.resize(static_cast<size_t>(NumRobots));
+	for (int32_t i = 0; i < NumRobots; i++)
+	{
+		sockaddr_in Addr = {};
+		Addr.sin_family      = AF_INET;
+		Addr.sin_addr.s_addr = HostIp;
+		Addr.sin_port        = htons(static_cast<uint16_t>(BasePort + i));
+		static_assert(sizeof(Addr) <= sizeof(Robots[i].Addr), "sockaddr_in 크기");
+		std::memcpy(Robots[i].Addr, &Addr, sizeof(Addr));
+	}
+
+	Socket = S;
+
+	// 서버는 클라이언트별 인코딩을 기억하므로 생성 시 1회 선택
+	if (bQuantized)
+		SendCommand("ENCODING Q16", nullptr);
+}
+
+FHexapodClient::~FHexapodClient()
+{
+	if (Socket == InvalidSocket) return;
+#if defined(_WIN32)
+	closesocket(Socket);
+	WSACleanup();
+#else
+	close(Socket);
+#endif
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 송신
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool FHexapodClient::SendToRobot(int32_t Robot, const char* Command, int32_t CommandLen, bool bExpectReply)
+{
+	FRobotState& R = Robots[static_cast<size_t>(Robot)];
+
+	// 미처리 ACK / KEYFRAME 요청은 같은 데이터그램 앞줄로 전송
+	int32_t Len = 0;
+	const bool bSendAck = !R.bNeedKeyframe && R.bHasPendingAck;
+	if (R.bNeedKeyframe)
+		Len += std::snprintf(SendBuffer + Len, sizeof(SendBuffer) - Len, "KEYFRAME\n");
+	else if (bSendAck)
+		Len += std::snprintf(SendBuffer + Len, sizeof(SendBuffer) - Len, "ACK %u\n", static_cast<unsigned>(R.PendingAck));
+
+	if (Len + CommandLen > static_cast<int32_t>(sizeof(SendBuffer))) return false;
+	std::memcpy(SendBuffer + Len, Command, static_cast<size_t>(CommandLen));
+	Len += CommandLen;
+
+	const int Sent = sendto(Socket, SendBuffer, Len, 0, reinterpret_cast<const sockaddr*>(R.Addr), sizeof(sockaddr_in));
+	if (Sent != Len) return false;
+
+	// 서버는 이 프레임을 기준으로 델타를 보냄 → 링에서 밀려나도 쓸 수 있게 사본 보관
+	if (bSendAck)
+	{
+		if (const HexapodObsCodec::FQuantFrame* Acked = R.Received.Find(R.PendingAck))
+		{
+			R.AckedFrame     = *Acked;
+			R.bHasAckedFrame = true;
+		}
+	}
+
+	R.bNeedKeyframe  = false;
+	R.bHasPendingAck = false;
+	if (bExpectReply) R.InFlight++;
+	return true;
+}
+
+int32_t FHexapodClient::SendJoints(const float* Actions, const uint8_t* Mask)
+{
+	if (!IsValid() || !Actions) return 0;
+
+	char Command[NumJoints * 16 + 8];
+	int32_t NumSent = 0;
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+	{
+		if (!IsMasked(Mask, r)) continue;
+
+		int32_t Len = std::snprintf(Command, sizeof(Command), "JOINTS");
+		const float* A = Actions + r * NumJoints;
+		for (int32_t j = 0; j < NumJoints; j++)
+			Len += std::snprintf(Command + Len, sizeof(Command) - Len, " %.4f", A[j]);
+
+		NumSent += SendToRobot(r, Command, Len) ? 1 : 0;
+	}
+	return NumSent;
+}
+
+int32_t FHexapodClient::SendInput(const float* Inputs, const uint8_t* Mask)
+{
+	if (!IsValid() || !Inputs) return 0;
+
+	char Command[64];
+	int32_t NumSent = 0;
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+	{
+		if (!IsMasked(Mask, r)) continue;
+		const int32_t Len = std::snprintf(Command, sizeof(Command), "INPUT %.4f %.4f", Inputs[r * 2], Inputs[r * 2 + 1]);
+		NumSent += SendToRobot(r, Command, Len) ? 1 : 0;
+	}
+	return NumSent;
+}
+
+int32_t FHexapodClient::SendCommand(const char* Command, const uint8_t* Mask)
+{
+	if (!IsValid() || !Command) return 0;
+
+	const int32_t Len = static_cast<int32_t>(std::strlen(Command));
+	int32_t NumSent = 0;
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+	{
+		if (!IsMasked(Mask, r)) continue;
+		NumSent += SendToRobot(r, Command, Len) ? 1 : 0;
+	}
+	return NumSent;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 수신
+// ─────────────────────────────────────────────────────────────────────────────
+
+int32_t FHexapodClient::RobotFromSender(uint32_t Ip, uint16_t Port) const
+{
+	const int32_t Index = static_cast<int32_t>(Port) - BasePort;
+	if (Ip != HostIp || Index < 0 || Index >= GetNumRobots()) return -1;
+	return Index;
+}
+
+int32_t FHexapodClient::Poll(int32_t TimeoutMs)
+{
+	if (!IsValid()) return 0;
+
+	// 첫 패킷 대기 (TimeoutMs == 0 이면 즉시 반환)
+	if (TimeoutMs > 0)
+	{
+#if defined(_WIN32)
+		WSAPOLLFD Pfd = { static_cast<SOCKET>(Socket), POLLRDNORM, 0 };
+		if (WSAPoll(&Pfd, 1, TimeoutMs) <= 0) return 0;
+#else
+		pollfd Pfd = { Socket, POLLIN, 0 };
+		if (poll(&Pfd, 1, TimeoutMs) <= 0) return 0;
+#endif
+	}
+
+	uint8_t Buffer[RecvBufferBytes];
+	int32_t NumHandled = 0;
+	for (;;)
+	{
+		sockaddr_in From = {};
+		socklen_t FromLen = sizeof(From);
+		const int Len = recvfrom(Socket, reinterpret_cast<char*>(Buffer), sizeof(Buffer) - 1, 0,
+		                         reinterpret_cast<sockaddr*>(&From), &FromLen);
+		if (Len <= 0) break;
+
+		const int32_t Robot = RobotFromSender(From.sin_addr.s_addr, ntohs(From.sin_port));
+		if (Robot < 0) continue;
+
+		const uint32_t Before = Robots[static_cast<size_t>(Robot)].ObsCount;
+		HandleDatagram(Robot, Buffer, Len);
+		NumHandled += Robots[static_cast<size_t>(Robot)].ObsCount != Before ? 1 : 0;
+	}
+	return NumHandled;
+}
+
+void FHexapodClient::HandleDatagram(int32_t Robot, uint8_t* Data, int32_t Len)
+{
+	FRobotState& R = Robots[static_cast<size_t>(Robot)];
+	if (R.InFlight > 0) R.InFlight--;
+
+	// ── Q16 바이너리 프레임 ───────────────────────────────────────────────────
+	HexapodObsCodec::EFrameType Type;
+	uint16_t Seq, BaseSeq;
+	if (HexapodObsCodec::PeekHeader(Data, Len, Type, Seq, BaseSeq))
+	{
+		HexapodObsCodec::FQuantFrame Frame;
+		const HexapodObsCodec::FQuantFrame* Base = nullptr;
+		if (Type == HexapodObsCodec::EFrameType::Delta)
+		{
+			Base = R.Received.Find(BaseSeq);
+			if (!Base && R.bHasAckedFrame && R.AckedFrame.Seq == BaseSeq) Base = &R.AckedFrame;
+		}
+		if (!HexapodObsCodec::Decode(Data, Len, Base, Frame))
+		{
+			R.bNeedKeyframe = true;
+			return;
+		}
+		R.Received.Store(Frame);
+		HexapodObsCodec::Dequantize(Frame.Values, QuantScale, R.Obs);
+		R.PendingAck     = Seq;
+		R.bHasPendingAck = true;
+
+		uint16_t Tag, Held;
+		if (HexapodObsCodec::ReadActionTag(Data, Len, Tag, Held))
+			SetActionTag(R, Tag, Held);
+
+		// 선택: 'F' 블록 (FEET 1 설정 시)
+		int16_t FeetQ[FootSize];
+		if (HexapodObsCodec::FindExtBlock(Data, Len, HexapodObsCodec::BlockFeet, FeetQ, FootSize) == FootSize)
+		{
+			for (int32_t i = 0; i < FootSize; i++)
+				R.Feet[i] = static_cast<float>(FeetQ[i]) * FootQuantScale.Step[i];
+			R.FeetCount++;
+		}
+		R.ObsCount++;
+		return;
+	}
+
+	// ── 텍스트 "OBS a0 ... yaw" ───────────────────────────────────────────────
+	char* Text = reinterpret_cast<char*>(Data);
+	Text[Len] = '\0';  // Poll 의 수신 버퍼는 1 byte 여유가 있음
+	if (std::strncmp(Text, "OBS", 3) != 0) return;
+
+	float Values[ObsSize];
+	char* P = Text + 3;
+	for (int32_t i = 0; i < ObsSize; i++)
+	{
+		char* End = nullptr;
+		Values[i] = std::strtof(P, &End);
+		if (End == P) return;
+		P = End;
+	}
+
+	// 선택: " SEQ n HELD h" (ACT / PIPELINE 사용 시)
+	while (*P == ' ') P++;
+	if (std::strncmp(P, "SEQ ", 4) == 0)
+	{
+		char* End = nullptr;
+		R.ObsActionSeq = static_cast<uint32_t>(std::strtoul(P + 4, &End, 10));
+		P = End;
+		while (*P == ' ') P++;
+		R.ObsHeld = std::strncmp(P, "HELD ", 5) == 0 ? static_cast<uint32_t>(std::strtoul(P + 5, &End, 10)) : 0;
+		P = End;
+		while (*P == ' ') P++;
+	}
+
+	// 선택: " FEET f0 ... f20" (FEET 1 설정 시)
+	if (std::strncmp(P, "FEET", 4) == 0)
+	{
+		float Feet[FootSize];
+		char* F = P + 4;
+		int32_t i = 0;
+		for (; i < FootSize; i++)
+		{
+			char* End = nullptr;
+			Feet[i] = std::strtof(F, &End);
+			if (End == F) break;
+			F = End;
+		}
+		if (i == FootSize)
+		{
+			std::memcpy(R.Feet, Feet, sizeof(Feet));
+			R.FeetCount++;
+		}
+	}
+
+	std::memcpy(R.Obs, Values, sizeof(Values));
+	R.ObsCount++;
+}
+
+void FHexapodClient::SetActionTag(FRobotState& R, uint16_t Tag, uint16_t Held)
+{
+	// 태그는 하위 16 bit → 마지막으로 보낸 순번 기준으로 복원
+	R.ObsActionSeq = R.ActionSeq - static_cast<uint16_t>(static_cast<uint16_t>(R.ActionSeq) - Tag);
+	R.ObsHeld      = Held;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 배치 스텝 / 조회
+// ─────────────────────────────────────────────────────────────────────────────
+
+int32_t FHexapodClient::TotalInFlight(const uint8_t* Mask) const
+{
+	int32_t Total = 0;
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+		if (IsMasked(Mask, r)) Total += Robots[static_cast<size_t>(r)].InFlight;
+	return Total;
+}
+
+int32_t FHexapodClient::Step(const float* Actions, float* OutObs, int32_t TimeoutMs)
+{
+	if (!IsValid()) return 0;
+
+	for (FRobotState& R : Robots)
+		R.StepMark = R.ObsCount;
+
+	SendJoints(Actions, nullptr);
+
+	// 앞서 파이프라인으로 보낸 요청까지 모두 돌아올 때까지 대기
+	const int64_t Deadline = NowMs() + TimeoutMs;
+	while (TotalInFlight(nullptr) > 0)
+	{
+		const int64_t Remaining = Deadline - NowMs();
+		if (Remaining <= 0) break;
+		Poll(static_cast<int32_t>(Remaining));
+	}
+
+	// 타임아웃: 유실된 UDP 응답은 더 기다리지 않음
+	int32_t NumReplied = 0;
+	for (FRobotState& R : Robots)
+	{
+		R.InFlight = 0;
+		NumReplied += R.ObsCount != R.StepMark ? 1 : 0;
+	}
+
+	CopyLatest(OutObs, nullptr);
+	return NumReplied;
+}
+
+void FHexapodClient::CopyLatest(float* OutObs, uint32_t* OutCounts) const
+{
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+	{
+		const FRobotState& R = Robots[static_cast<size_t>(r)];
+		if (OutObs)    std::memcpy(OutObs + r * ObsSize, R.Obs, sizeof(R.Obs));
+		if (OutCounts) OutCounts[r] = R.ObsCount;
+	}
+}
+
+int32_t FHexapodClient::GetInFlight(int32_t Robot) const
+{
+	return (Robot >= 0 && Robot < GetNumRobots()) ? Robots[static_cast<size_t>(Robot)].InFlight : 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 발끝 FK
+// ─────────────────────────────────────────────────────────────────────────────
+
+int32_t FHexapodClient::EnableFeet(bool bEnabled)
+{
+	return SendCommand(bEnabled ? "FEET 1" : "FEET 0", nullptr);
+}
+
+int32_t FHexapodClient::CopyLatestFeet(float* OutFeet, uint32_t* OutCounts) const
+{
+	int32_t NumWithFeet = 0;
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+	{
+		const FRobotState& R = Robots[static_cast<size_t>(r)];
+		if (OutFeet)   std::memcpy(OutFeet + r * FootSize, R.Feet, sizeof(R.Feet));
+		if (OutCounts) OutCounts[r] = R.FeetCount;
+		NumWithFeet += R.FeetCount > 0 ? 1 : 0;
+	}
+	return NumWithFeet;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 파이프라인 스텝
+// ─────────────────────────────────────────────────────────────────────────────
+
+int32_t FHexapodClient::EnablePipeline(int32_t Depth, bool bHoldStand)
+{
+	if (!IsValid()) return 0;
+	PipelineDepth = Depth < 0 ? 0 : Depth;
+
+	char Command[48];
+	const int32_t Len = std::snprintf(Command, sizeof(Command), "PIPELINE %d %s", PipelineDepth, bHoldStand ? "STAND" : "LAST");
+
+	// 서버도 행동 순번을 0 으로 되돌림. Depth 0 이면 요청/응답 → 이 명령의 응답 1개를 기다림
+	int32_t NumSent = 0;
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+	{
+		FRobotState& R = Robots[static_cast<size_t>(r)];
+		R.ActionSeq = R.ObsActionSeq = R.ObsHeld = 0;
+		NumSent += SendToRobot(r, Command, Len, PipelineDepth == 0) ? 1 : 0;
+	}
+	return NumSent;
+}
+
+int32_t FHexapodClient::StepPipelined(const float* Actions, float* OutObs, uint32_t* OutActionSeq, int32_t TimeoutMs)
+{
+	if (!IsValid() || !Actions) return 0;
+
+	char Command[NumJoints * 16 + 24];
+	for (int32_t r = 0; r < GetNumRobots(); r++)
+	{
+		FRobotState& R = Robots[static_cast<size_t>(r)];
+		int32_t Len = std::snprintf(Command, sizeof(Command), "ACT %u", static_cast<unsigned>(++R.ActionSeq));
+		const float* A = Actions + r * NumJoints;
+		for (int32_t j = 0; j < NumJoints; j++)
+			Len += std::snprintf(Command + Len, sizeof(Command) - Len, " %.4f", A[j]);
+
+		// 스트리밍 중에는 ACT 마다 오는 응답이 없음
+		SendToRobot(r, Command, Len, PipelineDepth == 0);
+	}
+
+	auto CountWithinDepth = [this]()
+	{
+		int32_t Count = 0;
+		for (const FRobotState& R : Robots)
+			Count += (R.ActionSeq - R.ObsActionSeq) <= static_cast<uint32_t>(PipelineDepth) ? 1 : 0;
+		return Count;
+	};
+
+	// 이미 도착한 스트림부터 반영 → 허용 지연 안이면 기다리지 않음
+	Poll(0);
+	int32_t NumWithin = CountWithinDepth();
+	const int64_t Deadline = NowMs() + TimeoutMs;
+	while (NumWithin < GetNumRobots())
+	{
+		const int64_t Remaining = Deadline - NowMs();
+		if (Remaining <= 0) break;
+		Poll(static_cast<int32_t>(Remaining));
+		NumWithin = CountWithinDepth();
+	}
+
+	if (PipelineDepth == 0)
+		for (FRobotState& R : Robots) R.InFlight = 0;
+
+	CopyLatest(OutObs, nullptr);
+	if (OutActionSeq)
+		for (int32_t r = 0; r < GetNumRobots(); r++)
+			OutActionSeq[r] = Robots[static_cast<size_t>(r)].ObsActionSeq;
+	return NumWithin;
+}
+
+uint32_t FHexapodClient::GetActionLag(int32_t Robot) const
+{
+	if (Robot < 0 || Robot >= GetNumRobots()) return 0;
+	const FRobotState& R = Robots[static_cast<size_t>(Robot)];
+	return R.ActionSeq - R.ObsActionSeq;
+}
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodClientC.h"
+#include "HexapodClient.h"
+
+#include <new>
+
+// C 핸들은 FHexapodClient 를 그대로 가리킴
+struct hexapod_client : FHexapodClient
+{
+	using FHexapodClient::FHexapodClient;
+};
+
+hexapod_client* hexapod_client_create(const char* host, int32_t base_port, int32_t num_robots, int32_t encoding)
+{
+	hexapod_client* Client = new (std::nothrow) hexapod_client(host, base_port, num_robots, encoding == HEXAPOD_ENCODING_Q16);
+	if (Client && !Client->IsValid())
+	{
+		delete Client;
+		return nullptr;
+	}
+	return Client;
+}
+
+void hexapod_client_destroy(hexapod_client* client)
+{
+	delete client;
+}
+
+int32_t hexapod_client_send_joints(hexapod_client* client, const float* actions, const uint8_t* mask)
+{
+	return client ? client->SendJoints(actions, mask) : 0;
+}
+
+int32_t hexapod_client_send_input(hexapod_client* client, const float* inputs, const uint8_t* mask)
+{
+	return client ? client->SendInput(inputs, mask) : 0;
+}
+
+int32_t hexapod_client_send_command(hexapod_client* client, const char* command, const uint8_t* mask)
+{
+	return client ? client->SendCommand(command, mask) : 0;
+}
+
+int32_t hexapod_client_poll(hexapod_client* client, int32_t timeout_ms)
+{
+	return client ? client->Poll(timeout_ms) : 0;
+}
+
+void hexapod_client_latest(const hexapod_client* client, float* obs, uint32_t* counts)
+{
+	if (client) client->CopyLatest(obs, counts);
+}
+
+int32_t hexapod_client_step(hexapod_client* client, const float* actions, float* obs, int32_t timeout_ms)
+{
+	return client ? client->Step(actions, obs, timeout_ms) : 0;
+}
+
+int32_t hexapod_client_in_flight(const hexapod_client* client, int32_t robot)
+{
+	return client ? client->GetInFlight(robot) : 0;
+}
+
+int32_t hexapod_client_feet(hexapod_client* client, int32_t enabled)
+{
+	return client ? client->EnableFeet(enabled != 0) : 0;
+}
+
+int32_t hexapod_client_latest_feet(const hexapod_client* client, float* feet, uint32_t* counts)
+{
+	return client ? client->CopyLatestFeet(feet, counts) : 0;
+}
+
+int32_t hexapod_client_pipeline(hexapod_client* client, int32_t depth, int32_t hold)
+{
+	return client ? client->EnablePipeline(depth, hold == HEXAPOD_HOLD_STAND) : 0;
+}
+
+int32_t hexapod_client_step_pipelined(hexapod_client* client, const float* actions, float* obs,
+                                      uint32_t* action_seqs, int32_t timeout_ms)
+{
+	return client ? client->StepPipelined(actions, obs, action_seqs, timeout_ms) : 0;
+}
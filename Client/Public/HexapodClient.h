@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "HexapodClientC.h"
+#include "HexapodObsCodec.h"
+#include "HexapodKinematics.h"
+
+/**
+ * FHexapodClient
+ *
+ * UE5 HexapodNetworkComponent 프로토콜을 말하는 네이티브 클라이언트.
+ * hexapod_interface.py 의 "패킷 1개 보내고 100 ms 블로킹 수신" 구조 대신
+ * 소켓 하나로 N대 로봇에 논블로킹 송신 → 도착한 응답만 모아서 처리.
+ *
+ *  - 로봇 i 의 엔드포인트 = Host : BasePort + i (로봇마다 ListenPort 가 다름)
+ *  - 응답은 송신 포트로 구분 → 로봇별 최신 관측값 + 수신 횟수 보관
+ *  - Q16 인코딩이면 HexapodObsCodec 으로 디코딩, ACK 는 다음 명령에 덧붙임
+ *  - 송수신 경로에서 힙 할당 없음 (버퍼는 생성 시 1회 확보)
+ *
+ * 파이프라인 스텝 (EnablePipeline → StepPipelined):
+ *  서버가 매 물리 스텝 OBS 를 밀어주고 각 OBS 에 반영된 행동 순번(SEQ)을 붙임.
+ *  StepPipelined 는 행동을 보낸 뒤 "가장 최근 관측이 Depth 스텝 이내의 행동을 반영"할 때까지만 기다림
+ *  → Depth ≥ 1 이면 정책 계산과 물리 스텝이 겹쳐 처리량 ≈ max(시뮬레이션, 정책).
+ *
+ * 발끝 FK (EnableFeet → CopyLatestFeet):
+ *  서버가 붙여 주는 발끝 위치 / 접지 마스크 / 안정 여유 / 지지 넓이 (HexapodKinematics.h).
+ *  TEXT 는 "FEET" 토큰, Q16 은 'F' 확장 블록 (HexapodObsCodec.h) — 둘 다 같은 Feet 로 복원.
+ */
+class FHexapodClient
+{
+public:
+	static constexpr int32_t NumJoints = 18;
+	static constexpr int32_t ObsSize   = HexapodObsCodec::NumFields;
+	static constexpr int32_t FootSize  = HexapodKinematics::FootFields;
+
+	FHexapodClient(const char* Host, int32_t BasePort, int32_t NumRobots, bool bQuantized);
+	~FHexapodClient();
+
+	FHexapodClient(const FHexapodClient&) = delete;
+	FHexapodClient& operator=(const FHexapodClient&) = delete;
+
+	bool IsValid() const { return Socket != InvalidSocket; }
+	int32_t GetNumRobots() const { return static_cast<int32_t>(Robots.size()); }
+
+	// ── 논블로킹 송신 (Mask == nullptr 이면 전체) ─────────────────────────────
+	int32_t SendJoints(const float* Actions, const uint8_t* Mask);
+	int32_t SendInput(const float* Inputs, const uint8_t* Mask);
+	int32_t SendCommand(const char* Command, const uint8_t* Mask);
+
+	/** 도착한 응답을 모두 처리. TimeoutMs 동안 첫 패킷을 기다림. 반환: 처리한 관측값 수 */
+	int32_t Poll(int32_t TimeoutMs);
+
+	/** 송신 + 모든 대상 로봇의 응답(또는 타임아웃)까지 대기. 반환: 응답한 로봇 수 */
+	int32_t Step(const float* Actions, float* OutObs, int32_t TimeoutMs);
+
+	/** 로봇별 최신 관측값 복사 (OutObs: N×24, OutCounts: N, 둘 다 nullptr 허용) */
+	void CopyLatest(float* OutObs, uint32_t* OutCounts) const;
+
+	int32_t GetInFlight(int32_t Robot) const;
+
+	// ── 발끝 FK ──────────────────────────────────────────────────────────────
+	/** 서버에 FEET 0|1 전송 — 켜면 이후 TEXT OBS 에 발끝 필드 21 개가 붙음 (기본 꺼짐) */
+	int32_t EnableFeet(bool bEnabled);
+
+	/**
+	 * 로봇별 최신 발끝 필드 복사 (OutFeet: N×21, OutCounts: N = FEET 가 붙은 관측 수, 둘 다 nullptr 허용).
+	 * 반환: 발끝 값을 한 번이라도 받은 로봇 수
+	 */
+	int32_t CopyLatestFeet(float* OutFeet, uint32_t* OutCounts) const;
+
+	// ── 파이프라인 스텝 ───────────────────────────────────────────────────────
+	/** 서버에 PIPELINE Depth 전송 (0 = 요청/응답으로 복귀). bHoldStand: 허용 지연 초과 시 서있는 자세 */
+	int32_t EnablePipeline(int32_t Depth, bool bHoldStand);
+
+	/**
+	 * 전체 로봇에 순번 붙은 행동(ACT) 송신 → 로봇마다 최신 관측이 반영한 행동이
+	 * 방금 보낸 것보다 Depth 이하로 뒤처질 때까지 대기 (또는 타임아웃).
+	 * OutObs: N×24, OutActionSeq: N (관측이 반영한 행동 순번, nullptr 허용). 반환: 허용 지연 안의 로봇 수
+	 */
+	int32_t StepPipelined(const float* Actions, float* OutObs, uint32_t* OutActionSeq, int32_t TimeoutMs);
+
+	/** 로봇별 (마지막으로 보낸 행동 순번 - 최신 관측이 반영한 행동 순번) */
+	uint32_t GetActionLag(int32_t Robot) const;
+
+private:
+#if defined(_WIN32)
+	using FSocketHandle = uintptr_t;
+	static constexpr FSocketHandle InvalidSocket = ~static_cast<FSocketHandle>(0);
+#else
+	using FSocketHandle = int;
+	static constexpr FSocketHandle InvalidSocket = -1;
+#endif
+
+	struct FRobotState
+	{
+		uint8_t  Addr[16] = {};          // sockaddr_in
+		float    Obs[ObsSize] = {};
+		uint32_t ObsCount = 0;
+		float    Feet[FootSize] = {};        // 최신 FEET 필드 (TEXT / Q16 'F' 블록)
+		uint32_t FeetCount = 0;
+		uint32_t StepMark = 0;           // Step() 시작 시점의 ObsCount
+		int32_t  InFlight = 0;
+
+		uint32_t ActionSeq    = 0;       // 마지막으로 보낸 ACT 순번
+		uint32_t ObsActionSeq = 0;       // 최신 관측이 반영한 행동 순번 (SEQ 태그)
+		uint32_t ObsHeld      = 0;       // 그 행동이 유지된 스텝 수 (HELD 태그)
+
+		uint16_t PendingAck = 0;
+		bool     bHasPendingAck = false;
+		bool     bNeedKeyframe  = false;
+		HexapodObsCodec::FFrameHistory Received;
+		// ACK 로 보낸 프레임 사본 — 스트리밍 중 ACK 가 뜸해도 델타 기준이 링에서 밀려나지 않게
+		HexapodObsCodec::FQuantFrame   AckedFrame;
+		bool     bHasAckedFrame = false;
+	};
+
+	FSocketHandle Socket = InvalidSocket;
+	int32_t       BasePort = 0;
+	uint32_t      HostIp = 0;            // network byte order
+	bool          bQuantized = false;
+	int32_t       PipelineDepth = 0;
+
+	std::vector<FRobotState> Robots;
+	HexapodObsCodec::FQuantScale QuantScale = HexapodObsCodec::FQuantScale::Default();
+	HexapodObsCodec::FFootQuantScale FootQuantScale = HexapodObsCodec::FFootQuantScale::Default();
+
+	/** 송신 조립 버퍼 — ACK/KEYFRAME 접두 + 명령 */
+	char SendBuffer[1024];
+
+	/** bExpectReply: 응답 1개를 기다리는 요청이면 InFlight 증가 (스트리밍 중 ACT 는 false) */
+	bool SendToRobot(int32_t Robot, const char* Command, int32_t CommandLen, bool bExpectReply = true);
+	void SetActionTag(FRobotState& R, uint16_t Tag, uint16_t Held);
+	void HandleDatagram(int32_t Robot, uint8_t* Data, int32_t Len);
+	int32_t RobotFromSender(uint32_t Ip, uint16_t Port) const;
+	int32_t TotalInFlight(const uint8_t* Mask) const;
+};
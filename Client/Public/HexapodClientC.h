@@ -0,0 +1,83 @@
+/*
+ * HexapodClientC.h — FHexapodClient 의 C ABI (Python ctypes 바인딩용)
+ *
+ * 모든 배열은 호출자 소유의 연속 버퍼 (numpy float32/uint8 C-contiguous 그대로 전달 가능).
+ *  actions : N × 18 float (도)
+ *  inputs  : N × 2  float (x, y)
+ *  obs     : N × 24 float (a0..a17 px py pz roll pitch yaw)
+ *  feet    : N × 21 float (발끝 xyz × 6, 접지 마스크, 안정 여유, 지지 넓이 — HexapodKinematics.h)
+ *  mask    : N uint8, NULL 이면 전체 로봇
+ */
+
+#ifndef HEXAPOD_CLIENT_C_H
+#define HEXAPOD_CLIENT_C_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+	#if defined(HEXAPOD_CLIENT_BUILD)
+		#define HEXAPOD_CLIENT_API __declspec(dllexport)
+	#else
+		#define HEXAPOD_CLIENT_API __declspec(dllimport)
+	#endif
+#else
+	#define HEXAPOD_CLIENT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct hexapod_client hexapod_client;
+
+enum
+{
+	HEXAPOD_ENCODING_TEXT = 0,
+	HEXAPOD_ENCODING_Q16  = 1,
+};
+
+enum
+{
+	HEXAPOD_HOLD_LAST  = 0,   /* 허용 지연을 넘어도 마지막 행동 유지 */
+	HEXAPOD_HOLD_STAND = 1,   /* 허용 지연을 넘으면 서있는 자세 */
+};
+
+/* 실패 시 NULL. 로봇 i 의 포트 = base_port + i */
+HEXAPOD_CLIENT_API hexapod_client* hexapod_client_create(const char* host, int32_t base_port, int32_t num_robots, int32_t encoding);
+HEXAPOD_CLIENT_API void            hexapod_client_destroy(hexapod_client* client);
+
+/* 논블로킹 송신. 반환: 보낸 로봇 수 */
+HEXAPOD_CLIENT_API int32_t hexapod_client_send_joints(hexapod_client* client, const float* actions, const uint8_t* mask);
+HEXAPOD_CLIENT_API int32_t hexapod_client_send_input(hexapod_client* client, const float* inputs, const uint8_t* mask);
+HEXAPOD_CLIENT_API int32_t hexapod_client_send_command(hexapod_client* client, const char* command, const uint8_t* mask);
+
+/* 도착한 응답 처리. 반환: 처리한 관측값 수 */
+HEXAPOD_CLIENT_API int32_t hexapod_client_poll(hexapod_client* client, int32_t timeout_ms);
+
+/* 최신 관측값 복사. obs / counts 는 NULL 허용 */
+HEXAPOD_CLIENT_API void    hexapod_client_latest(const hexapod_client* client, float* obs, uint32_t* counts);
+
+/* 배치 스텝: 전체 로봇에 JOINTS 송신 후 응답 대기 → obs 에 기록. 반환: 응답한 로봇 수 */
+HEXAPOD_CLIENT_API int32_t hexapod_client_step(hexapod_client* client, const float* actions, float* obs, int32_t timeout_ms);
+
+HEXAPOD_CLIENT_API int32_t hexapod_client_in_flight(const hexapod_client* client, int32_t robot);
+
+/* 발끝 FK 필드 켜기/끄기 (TEXT 인코딩만, 기본 꺼짐). 반환: 보낸 로봇 수 */
+HEXAPOD_CLIENT_API int32_t hexapod_client_feet(hexapod_client* client, int32_t enabled);
+
+/* 최신 발끝 필드 복사. feet / counts(FEET 가 붙은 관측 수) 는 NULL 허용. 반환: 발끝 값을 받은 로봇 수 */
+HEXAPOD_CLIENT_API int32_t hexapod_client_latest_feet(const hexapod_client* client, float* feet, uint32_t* counts);
+
+/* 파이프라인 스텝: depth = 허용 지연 스텝 수 (0 = 요청/응답), hold = HEXAPOD_HOLD_*. 반환: 보낸 로봇 수 */
+HEXAPOD_CLIENT_API int32_t hexapod_client_pipeline(hexapod_client* client, int32_t depth, int32_t hold);
+
+/* 순번 붙은 행동 송신 후 관측이 depth 이내의 행동을 반영할 때까지만 대기.
+   action_seqs: N uint32 (각 관측이 반영한 행동 순번, NULL 허용). 반환: 허용 지연 안의 로봇 수 */
+HEXAPOD_CLIENT_API int32_t hexapod_client_step_pipelined(hexapod_client* client, const float* actions, float* obs,
+                                                         uint32_t* action_seqs, int32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEXAPOD_CLIENT_C_H */
@@ -0,0 +1,405 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * HexapodLoopbackServer
+ *
+ * UE5 없이 클라이언트 라이브러리를 시험하기 위한 대역 서버.
+ * HexapodNetworkComponent 와 같은 프로토콜(JOINTS / INPUT / RESET / OBS_REQ /
+ * ENCODING / ACK / KEYFRAME / ACT / PIPELINE / FEET, 줄 단위 묶음)을 N개 포트에서 흉내냄.
+ * 관절 각도는 목표값을 1차 지연으로 따라가고, INPUT 은 위치/yaw 를 적분.
+ * 요청/응답은 응답마다 한 스텝, PIPELINE 클라이언트가 있으면 step_ms 마다 스텝하며 OBS 를 밀어줌.
+ *
+ *   사용법: hexapod_loopback_server [base_port=7777] [num_robots=1] [step_ms=2]
+ */
+
+#include "HexapodObsCodec.h"
+#include "HexapodKinematics.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+	using socklen_t = int;
+	using FSocketHandle = SOCKET;
+#else
+	#include <arpa/inet.h>
+	#include <netinet/in.h>
+	#include <sys/select.h>
+	#include <sys/socket.h>
+	#include <unistd.h>
+	using FSocketHandle = int;
+#endif
+
+namespace
+{
+	constexpr int32_t MaxClients = 8;
+
+	struct FClient
+	{
+		uint32_t Ip = 0;
+		uint16_t Port = 0;
+		bool     bQuantized = false;
+		uint16_t NextSeq = 0;
+		bool     bHasAck = false;
+		bool     bStreaming = false;
+		bool     bTagAction = false;
+		bool     bSendFeet = false;
+		HexapodObsCodec::FQuantFrame   Acked;
+		HexapodObsCodec::FFrameHistory Sent;
+	};
+
+	struct FRobot
+	{
+		FSocketHandle Socket;
+		float Targets[18];
+		float Angles[18];
+		float Pos[3] = { 0.f, 0.f, 12.f };
+		float Yaw = 0.f;
+		float Input[2] = { 0.f, 0.f };
+		FClient Clients[MaxClients];
+		int32_t NumClients = 0;
+		int32_t NextEvict = 0;
+
+		// 행동 슬롯 (Pending → 스텝 시작 시 Applied)
+		float    PendingAction[18];
+		uint32_t PendingSeq = 0;
+		bool     bPendingAction = false;
+		uint32_t AppliedSeq = 0;
+		uint32_t Held = 0;
+		int32_t  Depth = 0;
+		bool     bHoldStand = false;
+
+		bool IsStreaming() const
+		{
+			for (int32_t i = 0; i < NumClients; i++)
+				if (Clients[i].bStreaming) return true;
+			return false;
+		}
+	};
+
+	void Standing(float* Angles)
+	{
+		for (int32_t i = 0; i < 6; i++)
+		{
+			Angles[i * 3 + 0] = 0.f;
+			Angles[i * 3 + 1] = 0.f;
+			Angles[i * 3 + 2] = 60.f;
+		}
+	}
+
+	FClient& FindOrAddClient(FRobot& R, uint32_t Ip, uint16_t Port)
+	{
+		for (int32_t i = 0; i < R.NumClients; i++)
+			if (R.Clients[i].Ip == Ip && R.Clients[i].Port == Port) return R.Clients[i];
+
+		int32_t Index = R.NumClients < MaxClients ? R.NumClients++ : (R.NextEvict++ % MaxClients);
+		R.Clients[Index] = FClient();
+		R.Clients[Index].Ip = Ip;
+		R.Clients[Index].Port = Port;
+		return R.Clients[Index];
+	}
+
+	/** 명령 한 줄 처리 — 응답이 필요하면 true */
+	bool ProcessCommand(FRobot& R, FClient& C, char* Line)
+	{
+		char* Tokens[24];	// ACT = 20 토큰
+		int32_t NumTokens = 0;
+		for (char* Tok = std::strtok(Line, " \t\r"); Tok && NumTokens < 24; Tok = std::strtok(nullptr, " \t\r"))
+			Tokens[NumTokens++] = Tok;
+		if (NumTokens == 0) return false;
+
+		const char* Cmd = Tokens[0];
+		if (!std::strcmp(Cmd, "JOINTS") && NumTokens == 19)
+		{
+			for (int32_t i = 0; i < 18; i++) R.Targets[i] = std::strtof(Tokens[i + 1], nullptr);
+		}
+		else if (!std::strcmp(Cmd, "ACT") && NumTokens == 20)
+		{
+			const uint32_t Seq = static_cast<uint32_t>(std::strtoul(Tokens[1], nullptr, 10));
+			const uint32_t Latest = R.bPendingAction ? R.PendingSeq : R.AppliedSeq;
+			if (static_cast<int32_t>(Seq - Latest) > 0)
+			{
+				for (int32_t i = 0; i < 18; i++) R.PendingAction[i] = std::strtof(Tokens[i + 2], nullptr);
+				R.PendingSeq = Seq;
+				R.bPendingAction = true;
+			}
+			C.bTagAction = true;
+		}
+		else if (!std::strcmp(Cmd, "PIPELINE") && NumTokens >= 2)
+		{
+			R.Depth = std::atoi(Tokens[1]);
+			if (R.Depth < 0) R.Depth = 0;
+			if (NumTokens >= 3) R.bHoldStand = !std::strcmp(Tokens[2], "STAND");
+			C.bStreaming = R.Depth > 0;
+			C.bTagAction = true;
+			R.PendingSeq = R.AppliedSeq = R.Held = 0;
+			R.bPendingAction = false;
+		}
+		else if (!std::strcmp(Cmd, "INPUT") && NumTokens == 3)
+		{
+			R.Input[0] = std::strtof(Tokens[1], nullptr);
+			R.Input[1] = std::strtof(Tokens[2], nullptr);
+		}
+		else if (!std::strcmp(Cmd, "RESET"))
+		{
+			Standing(R.Targets);
+		}
+		else if (!std::strcmp(Cmd, "ENCODING") && NumTokens == 2)
+		{
+			C.bQuantized = !std::strcmp(Tokens[1], "Q16");
+			C.bHasAck = false;
+			C.Sent.Reset();
+		}
+		else if (!std::strcmp(Cmd, "ACK") && NumTokens == 2)
+		{
+			const uint16_t Seq = static_cast<uint16_t>(std::atoi(Tokens[1]));
+			const HexapodObsCodec::FQuantFrame* Frame = C.Sent.Find(Seq);
+			if (Frame && (!C.bHasAck || HexapodObsCodec::IsNewer(Seq, C.Acked.Seq)))
+			{
+				C.Acked = *Frame;
+				C.bHasAck = true;
+			}
+			return false;
+		}
+		else if (!std::strcmp(Cmd, "FEET") && NumTokens == 2)
+		{
+			C.bSendFeet = std::atoi(Tokens[1]) != 0;
+		}
+		else if (!std::strcmp(Cmd, "KEYFRAME"))
+		{
+			C.bHasAck = false;
+			return false;
+		}
+		return true;
+	}
+
+	/** 스텝 시작: 새 행동이 있으면 적용, 없으면 유지 (허용 지연 초과 + STAND 면 서있는 자세) */
+	void CommitAction(FRobot& R)
+	{
+		if (R.bPendingAction)
+		{
+			std::memcpy(R.Targets, R.PendingAction, sizeof(R.Targets));
+			R.AppliedSeq = R.PendingSeq;
+			R.bPendingAction = false;
+			R.Held = 0;
+		}
+		else if (++R.Held > static_cast<uint32_t>(R.Depth) && R.bHoldStand)
+		{
+			Standing(R.Targets);
+		}
+	}
+
+	/** 한 스텝 진행 — 관절은 목표값의 절반만큼 다가가고, 위치는 INPUT 으로 적분 */
+	void Advance(FRobot& R)
+	{
+		for (int32_t i = 0; i < 18; i++)
+			R.Angles[i] += 0.5f * (R.Targets[i] - R.Angles[i]);
+
+		R.Yaw    += R.Input[1] * 0.5f;
+		const float YawRad = R.Yaw * 3.14159265f / 180.f;
+		R.Pos[0] += R.Input[0] * std::cos(YawRad);
+		R.Pos[1] += R.Input[0] * std::sin(YawRad);
+	}
+
+	void ComputeFeet(const FRobot& R, float* OutFeet)
+	{
+		// 관절값은 명령 기준 (서있는 자세 0/0/60) → FK 입력 각도로:
+		// Hip 에 장착 Yaw (HipRotations), Thigh 에 정지 Pitch 10°, Calf 에 정지 Yaw 90°
+		const float MountYaw[6] = { 45.f, 0.f, -45.f, 135.f, -180.f, -135.f };
+		float Angles[18];
+		for (int32_t i = 0; i < 6; i++)
+		{
+			Angles[i * 3 + 0] = R.Angles[i * 3 + 0] + MountYaw[i];
+			Angles[i * 3 + 1] = R.Angles[i * 3 + 1] + 10.f;
+			Angles[i * 3 + 2] = R.Angles[i * 3 + 2] + 90.f;
+		}
+
+		// 몸통은 항상 수평 → 아래 방향 = -Z
+		const float Down[3] = { 0.f, 0.f, -1.f };
+		HexapodKinematics::ComputeFootObservation(HexapodKinematics::FLegGeometry::Default(), Angles, Down, OutFeet);
+	}
+
+	void Reply(FRobot& R, FClient& C, const sockaddr_in& To)
+	{
+		float Obs[HexapodObsCodec::NumFields];
+		std::memcpy(Obs, R.Angles, sizeof(R.Angles));
+		Obs[18] = R.Pos[0]; Obs[19] = R.Pos[1]; Obs[20] = R.Pos[2];
+		Obs[21] = 0.f;      Obs[22] = 0.f;      Obs[23] = R.Yaw;
+
+		char Buffer[1024];
+		int32_t Len = 0;
+		if (C.bQuantized)
+		{
+			HexapodObsCodec::FQuantFrame Frame;
+			Frame.Seq = C.NextSeq++;
+			HexapodObsCodec::Quantize(Obs, HexapodObsCodec::FQuantScale::Default(), Frame.Values);
+			uint8_t* Out = reinterpret_cast<uint8_t*>(Buffer);
+			Len = C.bHasAck ? HexapodObsCodec::EncodeDelta(Frame, C.Acked, Out) : HexapodObsCodec::EncodeKey(Frame, Out);
+			C.Sent.Store(Frame);
+			if (C.bSendFeet)
+			{
+				const HexapodObsCodec::FFootQuantScale FootScale = HexapodObsCodec::FFootQuantScale::Default();
+				float Feet[HexapodKinematics::FootFields];
+				int16_t FeetQ[HexapodKinematics::FootFields];
+				ComputeFeet(R, Feet);
+				for (int32_t i = 0; i < HexapodKinematics::FootFields; i++)
+					FeetQ[i] = HexapodObsCodec::QuantizeValue(Feet[i], FootScale.Step[i]);
+				const int32_t BodyLen = Len;
+				Len = HexapodObsCodec::AppendExtBlock(Out, Len, HexapodObsCodec::BlockFeet, FeetQ, HexapodKinematics::FootFields);
+				Len = HexapodObsCodec::FinishExt(Out, Len, BodyLen);
+			}
+			if (C.bTagAction)
+				Len = HexapodObsCodec::AppendActionTag(Out, Len, static_cast<uint16_t>(R.AppliedSeq), static_cast<uint16_t>(R.Held));
+		}
+		else
+		{
+			Len = std::snprintf(Buffer, sizeof(Buffer), "OBS");
+			for (float V : Obs) Len += std::snprintf(Buffer + Len, sizeof(Buffer) - Len, " %.4f", V);
+			if (C.bTagAction)
+				Len += std::snprintf(Buffer + Len, sizeof(Buffer) - Len, " SEQ %u HELD %u", R.AppliedSeq, R.Held);
+			if (C.bSendFeet)
+			{
+				float Feet[HexapodKinematics::FootFields];
+				ComputeFeet(R, Feet);
+				Len += std::snprintf(Buffer + Len, sizeof(Buffer) - Len, " FEET");
+				for (float V : Feet) Len += std::snprintf(Buffer + Len, sizeof(Buffer) - Len, " %.4f", V);
+			}
+			Len += std::snprintf(Buffer + Len, sizeof(Buffer) - Len, "\n");
+		}
+		sendto(R.Socket, Buffer, Len, 0, reinterpret_cast<const sockaddr*>(&To), sizeof(To));
+	}
+
+	void HandlePacket(FRobot& R, char* Packet, const sockaddr_in& From)
+	{
+		FClient& C = FindOrAddClient(R, From.sin_addr.s_addr, From.sin_port);
+
+		bool bReply = false;
+		for (char* Line = Packet; Line && *Line; )
+		{
+			char* Next = std::strchr(Line, '\n');
+			if (Next) *Next++ = '\0';
+			bReply |= ProcessCommand(R, C, Line);
+			Line = Next;
+		}
+
+		// 스트리밍 클라이언트의 명령은 다음 정기 스텝에 반영
+		if (bReply && !C.bStreaming)
+		{
+			if (R.bPendingAction) CommitAction(R);
+			Advance(R);
+			Reply(R, C, From);
+		}
+	}
+
+	/** 정기 스텝 (PIPELINE) — 스트리밍 클라이언트 모두에게 OBS */
+	void StreamStep(FRobot& R)
+	{
+		CommitAction(R);
+		Advance(R);
+		for (int32_t i = 0; i < R.NumClients; i++)
+		{
+			FClient& C = R.Clients[i];
+			if (!C.bStreaming) continue;
+			sockaddr_in To = {};
+			To.sin_family      = AF_INET;
+			To.sin_addr.s_addr = C.Ip;
+			To.sin_port        = C.Port;
+			Reply(R, C, To);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const int32_t BasePort  = argc > 1 ? std::atoi(argv[1]) : 7777;
+	const int32_t NumRobots = argc > 2 ? std::atoi(argv[2]) : 1;
+	const int32_t StepMs    = argc > 3 ? std::atoi(argv[3]) : 2;
+	if (NumRobots <= 0 || StepMs <= 0) return 1;
+
+#if defined(_WIN32)
+	WSADATA WsaData;
+	WSAStartup(MAKEWORD(2, 2), &WsaData);
+#endif
+
+	std::vector<FRobot> Robots(static_cast<size_t>(NumRobots));
+	for (int32_t i = 0; i < NumRobots; i++)
+	{
+		FRobot& R = Robots[static_cast<size_t>(i)];
+		Standing(R.Targets);
+		Standing(R.Angles);
+
+		R.Socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		sockaddr_in Addr = {};
+		Addr.sin_family      = AF_INET;
+		Addr.sin_addr.s_addr = htonl(INADDR_ANY);
+		Addr.sin_port        = htons(static_cast<uint16_t>(BasePort + i));
+		if (bind(R.Socket, reinterpret_cast<sockaddr*>(&Addr), sizeof(Addr)) != 0)
+		{
+			std::fprintf(stderr, "hexapod_loopback_server: port %d bind failed\n", BasePort + i);
+			return 1;
+		}
+	}
+	std::printf("hexapod_loopback_server: %d robot(s) on UDP %d..%d\n", NumRobots, BasePort, BasePort + NumRobots - 1);
+	std::fflush(stdout);
+
+	using FClock = std::chrono::steady_clock;
+	const FClock::duration StepPeriod = std::chrono::milliseconds(StepMs);
+	FClock::time_point NextStep = FClock::now() + StepPeriod;
+
+	char Packet[2048];
+	for (;;)
+	{
+		bool bAnyStreaming = false;
+		for (const FRobot& R : Robots) bAnyStreaming |= R.IsStreaming();
+
+		// 정기 스텝 시각이 되면 스트리밍 로봇 진행
+		const FClock::time_point Now = FClock::now();
+		if (!bAnyStreaming)
+		{
+			NextStep = Now + StepPeriod;
+		}
+		else if (Now >= NextStep)
+		{
+			for (FRobot& R : Robots)
+				if (R.IsStreaming()) StreamStep(R);
+			NextStep += StepPeriod;
+			if (NextStep < Now) NextStep = Now + StepPeriod;   // 밀렸으면 따라잡지 않음
+			continue;
+		}
+
+		fd_set ReadSet;
+		FD_ZERO(&ReadSet);
+		FSocketHandle MaxFd = 0;
+		for (const FRobot& R : Robots)
+		{
+			FD_SET(R.Socket, &ReadSet);
+			if (R.Socket > MaxFd) MaxFd = R.Socket;
+		}
+		timeval Timeout = {};
+		if (bAnyStreaming)
+		{
+			const long long WaitUs = std::chrono::duration_cast<std::chrono::microseconds>(NextStep - Now).count();
+			Timeout.tv_sec  = static_cast<long>(WaitUs / 1000000);
+			Timeout.tv_usec = static_cast<long>(WaitUs % 1000000);
+		}
+		if (select(static_cast<int>(MaxFd + 1), &ReadSet, nullptr, nullptr, bAnyStreaming ? &Timeout : nullptr) <= 0) continue;
+
+		for (FRobot& R : Robots)
+		{
+			if (!FD_ISSET(R.Socket, &ReadSet)) continue;
+
+			sockaddr_in From = {};
+			socklen_t FromLen = sizeof(From);
+			const int Len = recvfrom(R.Socket, Packet, sizeof(Packet) - 1, 0, reinterpret_cast<sockaddr*>(&From), &FromLen);
+			if (Len <= 0) continue;
+			Packet[Len] = '\0';
+			HandlePacket(R, Packet, From);
+		}
+	}
+}
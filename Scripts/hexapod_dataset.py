@@ -0,0 +1,86 @@
+"""
+hexapod_dataset.py — UE5 오프라인 RL 데이터셋(HexapodDatasetSubsystem) 로더
+
+엔진이 샤드마다 열(column) 별 .npy 파일을 쓰므로 파싱 없이 np.load(mmap_mode='r') 로 매핑.
+
+== 기록 (UE5 콘솔) ==
+    Hexapod.Dataset start [디렉터리] [샤드 행 수]
+    Hexapod.Dataset stop
+
+== 디렉터리 구조 ==
+    index.json                      열 dtype/shape, 샤드 목록 (샤드 완료마다 갱신)
+    shard_00000/obs.npy             (rows, 45) float32  OBS 24 + FEET 21 (행동을 고른 시점)
+    shard_00000/action.npy          (rows, 18) float32  적용된 관절 목표
+    shard_00000/reward.npy          (rows,)    float32
+    shard_00000/done.npy            (rows,)    uint8    에피소드의 마지막 전이 (RESET/LOAD 직전, 넘어짐)
+    shard_00000/episode.npy         (rows,)    int32
+    shard_00000/robot.npy           (rows,)    int32
+
+== 사용법 ==
+    from hexapod_dataset import HexapodDataset
+
+    ds = HexapodDataset('Saved/HexapodDataset/2026.10.19-12.00.00')
+    print(len(ds), ds.columns)
+    for shard in ds.shards():           # 샤드 하나씩 (메모리 매핑 뷰)
+        obs, act = shard['obs'], shard['action']
+    rewards = ds.column('reward')       # 전체 이어 붙이기 (복사)
+    next_obs, valid = ds.next_obs()     # 같은 로봇·같은 에피소드 다음 행의 obs, done 행은 valid=False
+
+== 끊긴 구간 ==
+    엔진이 행을 버리거나 (쓰기 버퍼 부족, index.json 'dropped_rows') 배치 스왑 제거로 로봇 자리가 바뀌면
+    done 없이 episode 번호가 바뀜 → 그 앞 행은 잘린(truncated) 에피소드의 끝, next_obs 로 잇지 않음.
+"""
+
+import json
+import os
+from typing import Dict, Iterator, Tuple
+
+import numpy as np
+
+
+COLUMNS = ('obs', 'action', 'reward', 'done', 'episode', 'robot')
+
+
+class HexapodDataset:
+    """index.json 기준으로 샤드를 메모리 매핑해 읽는 읽기 전용 데이터셋."""
+
+    def __init__(self, path: str):
+        self.path = path
+        with open(os.path.join(path, 'index.json'), encoding='utf-8') as f:
+            self.index = json.load(f)
+        if self.index.get('format') != 'hexapod-offline-rl':
+            raise ValueError(f"알 수 없는 데이터셋 형식: {self.index.get('format')}")
+        self.columns = self.index['columns']
+
+    def __len__(self) -> int:
+        return int(self.index['total_rows'])
+
+    def shards(self) -> Iterator[Dict[str, np.ndarray]]:
+        """샤드마다 {열 이름: 메모리 매핑 배열}"""
+        for entry in self.index['shards']:
+            shard_dir = os.path.join(self.path, entry['dir'])
+            yield {name: np.load(os.path.join(shard_dir, f'{name}.npy'), mmap_mode='r') for name in COLUMNS}
+
+    def column(self, name: str) -> np.ndarray:
+        """모든 샤드의 한 열을 이어 붙인 배열 (복사본)"""
+        return np.concatenate([shard[name] for shard in self.shards()])
+
+    def next_obs(self) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        각 행의 다음 관측 = 같은 robot 의 다음 행 obs (같은 episode 일 때만).
+
+        Returns:
+            (next_obs (rows, 45), valid (rows,) bool) — done 행, 다음 행이 없거나 다른 episode (끊긴 구간) 면 valid=False
+        """
+        obs     = self.column('obs')
+        robot   = self.column('robot')
+        episode = self.column('episode')
+        done    = self.column('done').astype(bool)
+
+        next_obs = np.zeros_like(obs)
+        valid    = np.zeros(len(obs), dtype=bool)
+        for r in np.unique(robot):
+            rows = np.nonzero(robot == r)[0]
+            next_obs[rows[:-1]] = obs[rows[1:]]
+            valid[rows[:-1]] = ~done[rows[:-1]] & (episode[rows[:-1]] == episode[rows[1:]])
+        return next_obs, valid
@@ -15,6 +15,10 @@ UE5 시뮬레이터와 실제 로봇(Pico)을 동시에 제어하는 통합 Pyth
     # 둘 다 (Sim-to-Real 동기화)
     iface = HexapodInterface(mode='both', robot_port='COM3')
 
+    # UE5 가 직접 Pico 로 미러링 (HexapodSerialBridgeComponent.DevicePath 설정 시)
+    # → 타이밍 기준이 UE5 하나. Python 은 'sim' 모드로만 연결
+    iface = HexapodInterface(mode='sim')
+
     # 18개 관절 각도 전송 (도 단위)
     obs = iface.send_joints([0, 0, 60] * 6)
     print(obs['angles'], obs['pos'], obs['rot'])
@@ -26,6 +30,28 @@ UE5 시뮬레이터와 실제 로봇(Pico)을 동시에 제어하는 통합 Pyth
     # 서있는 자세로 리셋
     iface.reset()
 
+    # 대역폭 절약: int16 양자화 + 델타 인코딩 (클라이언트별 선택)
+    iface.set_encoding('q16')
+
+    # 최근 4 프레임 센서 히스토리 (지연/노이즈 적용, TEXT 인코딩)
+    obs = iface.set_history(4)
+    print(obs['history'][0])
+
+    # 기동 대기 (env 풀 재시작 / CI): READY 를 받을 때까지 HELLO 반복, 기동 시간 내역 반환
+    ready = iface.wait_ready(timeout=60.0)
+    print(ready['total_ms'], ready['map_ms'])
+
+    # 파이프라인 스텝: 관측 t 로 정책을 계산하는 동안 시뮬레이션은 스텝 t+1 진행
+    obs = iface.set_pipeline(depth=1, hold='last')
+    for _ in range(1000):
+        obs = iface.act(policy(obs))     # obs['seq']: 이 관측이 반영한 행동 순번
+    iface.set_pipeline(0)
+
+    # 분기 롤아웃: 슬롯 0 저장 → 여러 행동 시도 → 매번 되돌림
+    iface.save_state(0)
+    for candidate in candidates:
+        obs = iface.load_state(0, joints=candidate)
+
     iface.close()
 
 == 프로토콜 ==
@@ -34,9 +60,26 @@ UE5 시뮬레이터와 실제 로봇(Pico)을 동시에 제어하는 통합 Pyth
         "INPUT  x  y"            → SetMoveForward / SetMoveRight
         "RESET"                  → 서있는 자세
         "OBS_REQ"                → 관측값만 요청
+        "ENCODING TEXT|Q16"      → OBS 인코딩 선택
+        "ACK seq"                → Q16 델타 기준 프레임 확인 (다음 패킷 앞에 '\n' 으로 붙여 전송)
+        "KEYFRAME"               → 델타 기준 분실 시 키프레임 요청
+        "HISTORY K"              → 응답에 센서 히스토리 K 프레임 추가 (TEXT / Q16, 최대 64)
+        "FEET 0|1"               → 발끝 FK 필드 끄기/켜기 (TEXT / Q16, 기본 꺼짐)
+        "SAVE k" / "LOAD k"      → 물리 상태 슬롯 저장 / 복원 (분기 롤아웃)
+        "HELLO"                  → 준비 확인 (READY 응답)
+        "ACT n a0 ... a17"       → 순번 n 이 붙은 관절 목표 (행동 슬롯, 최신 것만 적용)
+        "PIPELINE D [LAST|STAND]"→ 파이프라인 스텝 (매 물리 스텝 OBS 스트림, D = 허용 지연 스텝)
 
     UE5 → Python (UDP 응답):
-        "OBS a0...a17 px py pz roll pitch yaw"
+        "OBS a0...a17 px py pz roll pitch yaw"      (TEXT)
+        "... SEQ n HELD h"                           (ACT/PIPELINE 사용 시: 반영된 행동 순번, 유지한 스텝 수)
+        "... FEET f0 ... f20"                        (FEET 1 설정 시: 발끝 xyz × 6 + 접지 마스크 + 안정 여유 + 지지 넓이)
+        "... HIST K h0 ... "                         (HISTORY 설정 시, 지연/노이즈 적용)
+        'Q' 바이너리 프레임 (54 bytes 키 / ~12-60 bytes 델타) (Q16, HexapodObsCodec.h)
+            + 확장 블록 'F' (FEET 1 설정 시, 21 int16) / 'H' (HISTORY 설정 시, K × 24 int16)
+        "READY port=P total_ms=.. engine_ms=.. map_ms=.. meshes_ms=.. spawn_ms=.. first_step_ms=.."
+                                                     (HELLO 응답, 기동 단계별 시간)
+        "BOOTING <단계> <ms>"                        (빠른 기동 중, 로봇 스폰 전)
 
     Python → Pico (Serial):
         동일한 텍스트 프로토콜 (JOINTS / RESET)
@@ -51,7 +94,9 @@ UE5 시뮬레이터와 실제 로봇(Pico)을 동시에 제어하는 통합 Pyth
     angles[leg*3+2] = Calf  (Tibia)
 """
 
+import select
 import socket
+import struct
 import time
 from typing import Optional
 
@@ -108,6 +153,21 @@ CALIBRATION: dict = {
 }
 
 
+# Q16 관측값 양자화 스텝 (HexapodObsCodec.h FQuantScale::Default 와 동기화)
+#   관절 18개: 0.01°,  위치 3개: 0.1 cm,  자세 3개: 0.01°
+Q16_STEP: list = [0.01] * 18 + [0.1] * 3 + [0.01] * 3
+Q16_MAGIC = ord('Q')
+Q16_TAG_BIT = 0x80
+Q16_EXT_BIT = 0x40
+
+# OBS 의 FEET 필드 수 (HexapodKinematics.h FootFields 와 동기화)
+FOOT_FIELDS = 21
+
+# Q16 'F' 블록 양자화 스텝 (HexapodObsCodec.h FFootQuantScale::Default 와 동기화)
+#   발끝 xyz 18개: 0.01 cm,  접지 마스크: 1,  안정 여유: 0.01 cm,  지지 넓이: 0.1 cm²
+Q16_FOOT_STEP: list = [0.01] * 18 + [1.0, 0.01, 0.1]
+
+
 # ─────────────────────────────────────────────────────────────────────────────
 # 변환 유틸리티
 # ─────────────────────────────────────────────────────────────────────────────
@@ -153,25 +213,173 @@ def angles_to_pulses(ue5_angles: list) -> dict:
     return pulses
 
 
+def _set_feet(obs: dict, feet: list):
+    """FEET 21 필드 → obs['feet'/'contact'/'margin'/'area'] (TEXT / Q16 공통)."""
+    obs['feet']    = [feet[i * 3:(i + 1) * 3] for i in range(6)]
+    obs['contact'] = int(feet[18])
+    obs['margin']  = feet[19]
+    obs['area']    = feet[20]
+
+
 def parse_observation(raw: str) -> dict:
     """
     UE5 OBS 패킷 파싱.
-    "OBS a0 a1 ... a17 px py pz roll pitch yaw"
+    "OBS a0 a1 ... a17 px py pz roll pitch yaw [SEQ n HELD h] [FEET f0 ... f20] [HIST K h0 ... h(K*24-1)]"
 
     Returns:
         {'angles': [18 floats], 'pos': [x,y,z], 'rot': [roll,pitch,yaw]}
+        SEQ 가 있으면 'seq': 이 관측이 반영한 행동 순번, 'held': 그 행동을 유지한 스텝 수
+        FEET 가 있으면 'feet': 6 개의 [x,y,z] (몸통 좌표계 cm), 'contact': 접지 비트마스크,
+                      'margin': 안정 여유 (cm, 지지 다각형 밖이면 음수), 'area': 지지 넓이 (cm²)
+        HIST 가 있으면 'history': K 개의 24-float 리스트 (최신 → 과거, 지연/노이즈 적용)
         또는 {} (파싱 실패 시)
     """
     tokens = raw.strip().split()
-    if len(tokens) != 25 or tokens[0] != 'OBS':
+    if len(tokens) < 25 or tokens[0] != 'OBS':
         return {}
-    values = list(map(float, tokens[1:]))
-    return {
+    values = list(map(float, tokens[1:25]))
+    obs = {
         'angles': values[:18],
         'pos':    values[18:21],
         'rot':    values[21:24],
     }
 
+    rest = tokens[25:]
+    if len(rest) >= 4 and rest[0] == 'SEQ' and rest[2] == 'HELD':
+        obs['seq']  = int(rest[1])
+        obs['held'] = int(rest[3])
+        rest = rest[4:]
+
+    if rest and rest[0] == 'FEET':
+        if len(rest) < 1 + FOOT_FIELDS:
+            return {}
+        _set_feet(obs, list(map(float, rest[1:1 + FOOT_FIELDS])))
+        rest = rest[1 + FOOT_FIELDS:]
+
+    if len(rest) >= 2 and rest[0] == 'HIST':
+        k = int(rest[1])
+        flat = list(map(float, rest[2:2 + k * 24]))
+        if len(flat) != k * 24:
+            return {}
+        obs['history'] = [flat[i * 24:(i + 1) * 24] for i in range(k)]
+    elif rest:
+        return {}
+    return obs
+
+
+class Q16Decoder:
+    """
+    Q16 바이너리 OBS 프레임 디코더 (HexapodObsCodec.h 와 같은 레이아웃).
+    최근 프레임을 seq 별로 보관해 델타 프레임의 기준으로 사용.
+    """
+
+    HISTORY = 16
+
+    def __init__(self):
+        self._frames: dict = {}   # seq → int16 24개 리스트
+        self._acked = None        # (seq, values) — ACK 로 보낸 기준 프레임 (링에서 밀려나도 유지)
+
+    def reset(self):
+        self._frames.clear()
+        self._acked = None
+
+    def pin(self, seq: int):
+        """ACK 로 보낸 프레임을 델타 기준으로 고정 (스트리밍 중 ACK 가 뜸해도 기준 유지)."""
+        values = self._frames.get(seq)
+        if values is not None:
+            self._acked = (seq, values)
+
+    def decode(self, data: bytes):
+        """
+        Returns:
+            (seq, 관측값 dict) 또는 None (형식 오류 / 기준 프레임 없음)
+        """
+        if len(data) < 6 or data[0] != Q16_MAGIC:
+            return None
+        flags = data[1]
+        ftype = flags & ~(Q16_TAG_BIT | Q16_EXT_BIT)
+        seq, base_seq = struct.unpack_from('<HH', data, 2)
+
+        # 행동 태그 (PIPELINE / ACT): 끝 4 bytes = action:u16 held:u16
+        tag = None
+        if flags & Q16_TAG_BIT:
+            if len(data) < 10:
+                return None
+            tag = struct.unpack_from('<HH', data, len(data) - 4)
+            data = data[:-4]
+
+        # 확장 블록: 본문 뒤 [id:u8 count:u16 int16 × count] … ext_bytes:u16
+        blocks = {}
+        if flags & Q16_EXT_BIT:
+            if len(data) < 8:
+                return None
+            (ext_len,) = struct.unpack_from('<H', data, len(data) - 2)
+            ext_end = len(data) - 2
+            p = ext_end - ext_len
+            if p < 6:
+                return None
+            data, ext = data[:p], data[p:ext_end]
+            p = 0
+            while len(ext) - p >= 3:
+                block_id = ext[p]
+                (count,) = struct.unpack_from('<H', ext, p + 1)
+                p += 3
+                if len(ext) - p < count * 2:
+                    return None
+                blocks[chr(block_id)] = struct.unpack_from(f'<{count}h', ext, p)
+                p += count * 2
+
+        if ftype == 0:
+            if len(data) != 6 + 48:
+                return None
+            values = list(struct.unpack_from('<24h', data, 6))
+        elif ftype == 1:
+            base = self._frames.get(base_seq)
+            if base is None and self._acked and self._acked[0] == base_seq:
+                base = self._acked[1]
+            if base is None or len(data) < 12:
+                return None
+            changed = int.from_bytes(data[6:9], 'little')
+            wide    = int.from_bytes(data[9:12], 'little')
+            values = list(base)
+            p = 12
+            for i in range(24):
+                if not changed & (1 << i):
+                    continue
+                if wide & (1 << i):
+                    (d,) = struct.unpack_from('<H', data, p)
+                    p += 2
+                else:
+                    (d,) = struct.unpack_from('<b', data, p)
+                    p += 1
+                values[i] = ((values[i] + d + 0x8000) & 0xFFFF) - 0x8000
+            if p != len(data):
+                return None
+        else:
+            return None
+
+        self._frames[seq] = values
+        self._frames.pop((seq - self.HISTORY) & 0xFFFF, None)
+
+        floats = [v * s for v, s in zip(values, Q16_STEP)]
+        obs = {
+            'angles': floats[:18],
+            'pos':    floats[18:21],
+            'rot':    floats[21:24],
+        }
+        if tag is not None:
+            obs['seq'], obs['held'] = tag   # 하위 16 bit 순번
+
+        feet = blocks.get('F')
+        if feet is not None and len(feet) == FOOT_FIELDS:
+            _set_feet(obs, [v * s for v, s in zip(feet, Q16_FOOT_STEP)])
+
+        hist = blocks.get('H')
+        if hist is not None and len(hist) % 24 == 0:
+            obs['history'] = [[v * s for v, s in zip(hist[i:i + 24], Q16_STEP)]
+                              for i in range(0, len(hist), 24)]
+        return seq, obs
+
 
 # ─────────────────────────────────────────────────────────────────────────────
 # 메인 인터페이스 클래스
@@ -205,6 +413,15 @@ class HexapodInterface:
         self.mode    = mode
         self.timeout = timeout
 
+        # ── OBS 인코딩 상태 (set_encoding) ────────────────────────────────────
+        self._q16 = Q16Decoder()
+        self._pending_ack: Optional[int] = None
+        self._pending_keyframe = False
+
+        # ── 파이프라인 상태 (set_pipeline / act) ──────────────────────────────
+        self._action_seq = 0
+        self._pipeline_depth = 0
+
         # ── UE5 UDP 소켓 ──────────────────────────────────────────────────────
         self._udp: Optional[socket.socket] = None
         self._sim_addr = (sim_host, sim_port)
@@ -248,7 +465,7 @@ class HexapodInterface:
 
         # UE5 전송
         if self._udp:
-            self._udp.sendto(packet.encode(), self._sim_addr)
+            self._send_sim(packet)
 
         # 실제 로봇 전송
         if self._ser:
@@ -267,7 +484,7 @@ class HexapodInterface:
         """
         packet = f"INPUT {x:.4f} {y:.4f}"
         if self._udp:
-            self._udp.sendto(packet.encode(), self._sim_addr)
+            self._send_sim(packet)
         # 참고: 실제 로봇에 INPUT 명령은 직접 적용 안 됨 (Pico는 각도만 처리)
 
     def reset(self) -> dict:
@@ -279,7 +496,7 @@ class HexapodInterface:
             UE5 관측값 딕셔너리
         """
         if self._udp:
-            self._udp.sendto(b"RESET", self._sim_addr)
+            self._send_sim("RESET")
         if self._ser:
             self._ser.write(b"RESET\n")
         return self._recv_observation()
@@ -292,9 +509,158 @@ class HexapodInterface:
             {'angles': [18 floats], 'pos': [x,y,z], 'rot': [roll,pitch,yaw]}
         """
         if self._udp:
-            self._udp.sendto(b"OBS_REQ", self._sim_addr)
+            self._send_sim("OBS_REQ")
+        return self._recv_observation()
+
+    def set_encoding(self, encoding: str) -> dict:
+        """
+        UE5 → Python OBS 인코딩 변경.
+
+        Args:
+            encoding: 'text' (%.4f 텍스트, 기본) 또는
+                      'q16'  (int16 고정소수점 + ACK 기준 델타, ~12-60 bytes)
+
+        Returns:
+            새 인코딩으로 받은 첫 관측값
+        """
+        enc = encoding.upper()
+        if enc not in ('TEXT', 'Q16'):
+            raise ValueError(f"알 수 없는 인코딩: {encoding}")
+        self._q16.reset()
+        self._pending_ack = None
+        if self._udp:
+            self._send_sim(f"ENCODING {enc}")
+        return self._recv_observation()
+
+    def set_history(self, k: int) -> dict:
+        """
+        응답에 최근 K 프레임 센서 히스토리를 붙이도록 설정 (0 = 끔).
+        지연/노이즈는 UE5 HexapodSensorComponent 설정을 따름.
+
+        Returns:
+            관측값 딕셔너리 — obs['history'] 는 K 개의 24-float 리스트 (최신 → 과거)
+        """
+        if self._udp:
+            self._send_sim(f"HISTORY {int(k)}")
+        return self._recv_observation()
+
+    def set_feet(self, enabled: bool) -> dict:
+        """
+        응답의 발끝 FK 필드를 켜거나 끔 (TEXT 는 FEET 토큰, Q16 은 'F' 확장 블록).
+
+        Returns:
+            관측값 딕셔너리 — 켜져 있으면 obs['feet'], obs['contact'], obs['margin'], obs['area']
+        """
+        if self._udp:
+            self._send_sim(f"FEET {1 if enabled else 0}")
+        return self._recv_observation()
+
+    def save_state(self, slot: int) -> dict:
+        """UE5 물리 상태(바디 19개 + 관절 목표 + 보행 위상)를 슬롯에 저장."""
+        if self._udp:
+            self._send_sim(f"SAVE {int(slot)}")
         return self._recv_observation()
 
+    def load_state(self, slot: int, joints: list = None) -> dict:
+        """
+        슬롯 복원. joints 를 주면 같은 데이터그램으로 보내 복원 직후 같은 물리 스텝에 적용.
+
+        Returns:
+            복원 + (행동) 이후 첫 물리 스텝의 관측값
+        """
+        packet = f"LOAD {int(slot)}"
+        if joints is not None:
+            if len(joints) != 18:
+                raise ValueError(f"관절 각도는 18개여야 합니다. 받은 개수: {len(joints)}")
+            packet += "\nJOINTS " + " ".join(f"{a:.4f}" for a in joints)
+        if self._udp:
+            self._send_sim(packet)
+        return self._recv_observation()
+
+    def wait_ready(self, timeout: float = 60.0) -> dict:
+        """
+        UE5 인스턴스가 명령을 받을 수 있을 때까지 HELLO 를 반복 전송 (env 풀 재시작, CI).
+        빠른 기동(-HexapodFastBoot) 중에는 BOOTING 응답이 오고, 첫 물리 스텝 뒤 READY.
+
+        Returns:
+            READY 의 key=value 딕셔너리 {'port': 7777, 'total_ms': ..., 'engine_ms': ..., ...}
+            timeout 안에 준비되지 않으면 {}
+        """
+        if not self._udp:
+            return {}
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            self._udp.sendto(b"HELLO", self._sim_addr)
+            try:
+                data, _ = self._udp.recvfrom(65536)
+            except socket.timeout:
+                continue
+            except (ConnectionResetError, ConnectionRefusedError):
+                # 아직 포트가 열리지 않음 (ICMP port unreachable)
+                time.sleep(self.timeout)
+                continue
+
+            tokens = data.decode(errors='replace').split()
+            if tokens and tokens[0] == 'READY':
+                ready = {}
+                for token in tokens[1:]:
+                    key, _, value = token.partition('=')
+                    ready[key] = int(value) if key == 'port' else float(value)
+                return ready
+        return {}
+
+    def set_pipeline(self, depth: int, hold: str = 'last') -> dict:
+        """
+        파이프라인 스텝 켜기/끄기. 켜면 UE5 가 매 물리 스텝 OBS 를 보내고, act() 는 응답을 기다리지 않음.
+
+        Args:
+            depth: 허용 지연 스텝 수 (0 = 요청/응답으로 복귀)
+            hold:  'last' 마지막 행동 유지 / 'stand' depth 를 넘게 새 행동이 없으면 서있는 자세
+
+        Returns:
+            관측값 딕셔너리 (스트림의 첫 관측)
+        """
+        if hold.lower() not in ('last', 'stand'):
+            raise ValueError(f"알 수 없는 hold 정책: {hold}")
+        self._pipeline_depth = max(0, int(depth))
+        self._action_seq = 0
+        if self._udp:
+            self._send_sim(f"PIPELINE {self._pipeline_depth} {hold.upper()}")
+        return self._recv_observation()
+
+    def act(self, angles: list) -> dict:
+        """
+        순번 붙은 행동(ACT) 송신 후, 반영된 행동이 depth 스텝 이내인 최신 관측을 반환.
+        스트림에 이미 쌓인 관측은 모두 비우고 가장 최신 것만 사용.
+
+        Returns:
+            관측값 딕셔너리 — obs['seq'] 가 이 관측을 만든 행동 순번, obs['held'] 는 그 행동을 유지한 스텝 수
+        """
+        if len(angles) != 18:
+            raise ValueError(f"관절 각도는 18개여야 합니다. 입력: {len(angles)}개")
+        self._action_seq += 1
+        packet = f"ACT {self._action_seq} " + " ".join(f"{a:.4f}" for a in angles)
+        if self._udp:
+            self._send_sim(packet)
+        if self._ser:
+            self._ser.write((f"JOINTS " + " ".join(f"{a:.4f}" for a in angles) + "\n").encode())
+
+        latest = {}
+        deadline = time.monotonic() + self.timeout
+        while time.monotonic() < deadline:
+            obs = self._recv_observation()
+            # 이미 도착한 관측은 모두 비우고 가장 최신 것만
+            while obs and self._has_pending():
+                obs = self._recv_observation() or obs
+            if not obs:
+                continue
+            latest = obs
+            # Q16 태그는 하위 16 bit 순번 → 차이도 16 bit 로 (지연은 작으므로 TEXT 도 동일)
+            lag = (self._action_seq - obs.get('seq', 0)) & 0xFFFF
+            if lag <= self._pipeline_depth:
+                break
+        return latest
+
     def close(self):
         """소켓 및 시리얼 포트 닫기."""
         if self._udp:
@@ -315,14 +681,43 @@ class HexapodInterface:
     # 내부 헬퍼
     # ─────────────────────────────────────────────────────────────────────────
 
+    def _has_pending(self) -> bool:
+        """소켓에 이미 도착한 관측이 더 있는지 (논블로킹 확인)."""
+        return bool(select.select([self._udp], [], [], 0)[0])
+
+    def _send_sim(self, packet: str):
+        """UE5 로 명령 전송. 미처리 Q16 ACK 가 있으면 같은 데이터그램 앞에 붙임."""
+        if self._pending_ack is not None:
+            packet = f"ACK {self._pending_ack}\n{packet}"
+            self._q16.pin(self._pending_ack)
+            self._pending_ack = None
+        if self._pending_keyframe:
+            packet = f"KEYFRAME\n{packet}"
+            self._pending_keyframe = False
+        self._udp.sendto(packet.encode(), self._sim_addr)
+
     def _recv_observation(self) -> dict:
-        """UE5로부터 OBS 패킷 수신 및 파싱."""
+        """UE5로부터 OBS 패킷 수신 및 파싱 (TEXT / Q16 자동 판별)."""
         if not self._udp:
             return {}
         try:
-            data, _ = self._udp.recvfrom(4096)
+            data, _ = self._udp.recvfrom(65536)
+        except socket.timeout:
+            return {}
+
+        if data[:1] == b'Q':
+            decoded = self._q16.decode(data)
+            if decoded is None:
+                # 델타 기준 분실 → 다음 명령에 키프레임 요청을 붙임
+                self._pending_keyframe = True
+                return {}
+            seq, obs = decoded
+            self._pending_ack = seq
+            return obs
+
+        try:
             return parse_observation(data.decode())
-        except (socket.timeout, UnicodeDecodeError):
+        except UnicodeDecodeError:
             return {}
 
 
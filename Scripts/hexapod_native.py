@@ -0,0 +1,285 @@
+"""
+hexapod_native.py — 네이티브 클라이언트 라이브러리(Client/) ctypes 바인딩
+
+hexapod_interface.py 는 호출마다 텍스트 패킷을 만들고 100 ms 타임아웃으로
+recvfrom 을 블로킹하기 때문에 스텝 속도가 클라이언트 쪽에서 막힘.
+이 모듈은 C++ 라이브러리(libhexapod_client)로 N대 로봇을 한 번에 스텝하고,
+numpy 버퍼를 포인터 그대로 넘겨 복사 없이 관측값을 받음.
+
+== 빌드 ==
+    cmake -S Client -B Client/Build && cmake --build Client/Build
+
+== 사용법 ==
+    import numpy as np
+    from hexapod_native import NativeHexapodClient
+
+    # UE5 에 로봇 4대 (ListenPort 7777~7780), Q16 인코딩
+    with NativeHexapodClient(num_robots=4, encoding='q16') as client:
+        actions = np.tile(np.array([0, 0, 60] * 6, np.float32), (4, 1))
+        obs = client.step(actions)          # (4, 24) float32, 내부 버퍼 뷰
+        print(obs[:, 18:21])                # 위치
+
+        # 파이프라인: 응답을 기다리지 않고 연속 송신 → 나중에 수거
+        client.send_joints(actions)
+        client.send_joints(actions)
+        client.poll(timeout_ms=5)
+        obs, counts = client.latest()
+
+        # 발끝 FK: 서버가 계산한 발끝 위치 / 접지 / 지지 다각형 (TEXT 인코딩 클라이언트만 — Q16 은 24 필드)
+        client.set_feet(True)
+        obs = client.step(actions)
+        feet, feet_counts = client.latest_feet()   # (4, 21)
+
+        # 파이프라인 스텝: 시뮬레이션이 매 물리 스텝 OBS 를 밀어주고, 정책 계산과 물리가 겹침
+        # depth = 허용 지연 (관측이 depth 스텝 전 행동까지 반영했으면 기다리지 않음)
+        client.pipeline(depth=1, hold='last')
+        for _ in range(1000):
+            obs, seqs = client.step_pipelined(policy(obs))   # seqs: 각 관측이 반영한 행동 순번
+
+== 로컬 시험 (UE5 없이) ==
+    Client/Build/hexapod_loopback_server 7777 4 [step_ms]
+"""
+
+import ctypes
+import os
+import sys
+from typing import Optional, Tuple
+
+import numpy as np
+
+
+ENCODINGS = {'text': 0, 'q16': 1}
+HOLD_POLICIES = {'last': 0, 'stand': 1}
+NUM_JOINTS = 18
+OBS_SIZE = 24
+FOOT_SIZE = 21   # HexapodKinematics.h FootFields
+
+_F32_P = ctypes.POINTER(ctypes.c_float)
+_U8_P  = ctypes.POINTER(ctypes.c_uint8)
+_U32_P = ctypes.POINTER(ctypes.c_uint32)
+
+
+def _default_library_path() -> str:
+    """HEXAPOD_CLIENT_LIB 환경 변수 → Client/Build 순으로 탐색."""
+    env = os.environ.get('HEXAPOD_CLIENT_LIB')
+    if env:
+        return env
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Client', 'Build')
+    if sys.platform == 'win32':
+        candidates = [os.path.join(root, 'Release', 'hexapod_client.dll'), os.path.join(root, 'hexapod_client.dll')]
+    elif sys.platform == 'darwin':
+        candidates = [os.path.join(root, 'libhexapod_client.dylib')]
+    else:
+        candidates = [os.path.join(root, 'libhexapod_client.so')]
+    for path in candidates:
+        if os.path.exists(path):
+            return path
+    return candidates[0]
+
+
+def _load_library(path: str) -> ctypes.CDLL:
+    lib = ctypes.CDLL(path)
+
+    lib.hexapod_client_create.argtypes  = [ctypes.c_char_p, ctypes.c_int32, ctypes.c_int32, ctypes.c_int32]
+    lib.hexapod_client_create.restype   = ctypes.c_void_p
+    lib.hexapod_client_destroy.argtypes = [ctypes.c_void_p]
+    lib.hexapod_client_destroy.restype  = None
+
+    lib.hexapod_client_send_joints.argtypes  = [ctypes.c_void_p, _F32_P, _U8_P]
+    lib.hexapod_client_send_joints.restype   = ctypes.c_int32
+    lib.hexapod_client_send_input.argtypes   = [ctypes.c_void_p, _F32_P, _U8_P]
+    lib.hexapod_client_send_input.restype    = ctypes.c_int32
+    lib.hexapod_client_send_command.argtypes = [ctypes.c_void_p, ctypes.c_char_p, _U8_P]
+    lib.hexapod_client_send_command.restype  = ctypes.c_int32
+
+    lib.hexapod_client_poll.argtypes      = [ctypes.c_void_p, ctypes.c_int32]
+    lib.hexapod_client_poll.restype       = ctypes.c_int32
+    lib.hexapod_client_latest.argtypes    = [ctypes.c_void_p, _F32_P, _U32_P]
+    lib.hexapod_client_latest.restype     = None
+    lib.hexapod_client_step.argtypes      = [ctypes.c_void_p, _F32_P, _F32_P, ctypes.c_int32]
+    lib.hexapod_client_step.restype       = ctypes.c_int32
+    lib.hexapod_client_in_flight.argtypes = [ctypes.c_void_p, ctypes.c_int32]
+    lib.hexapod_client_in_flight.restype  = ctypes.c_int32
+
+    lib.hexapod_client_feet.argtypes        = [ctypes.c_void_p, ctypes.c_int32]
+    lib.hexapod_client_feet.restype         = ctypes.c_int32
+    lib.hexapod_client_latest_feet.argtypes = [ctypes.c_void_p, _F32_P, _U32_P]
+    lib.hexapod_client_latest_feet.restype  = ctypes.c_int32
+
+    lib.hexapod_client_pipeline.argtypes      = [ctypes.c_void_p, ctypes.c_int32, ctypes.c_int32]
+    lib.hexapod_client_pipeline.restype       = ctypes.c_int32
+    lib.hexapod_client_step_pipelined.argtypes = [ctypes.c_void_p, _F32_P, _F32_P, _U32_P, ctypes.c_int32]
+    lib.hexapod_client_step_pipelined.restype  = ctypes.c_int32
+    return lib
+
+
+def _as_f32(array: np.ndarray, shape: tuple, name: str) -> np.ndarray:
+    """float32 C-contiguous 면 그대로 (복사 없음), 아니면 1회 변환."""
+    array = np.ascontiguousarray(array, dtype=np.float32)
+    if array.shape != shape:
+        raise ValueError(f"{name} shape 은 {shape} 여야 합니다. 입력: {array.shape}")
+    return array
+
+
+class NativeHexapodClient:
+    """
+    libhexapod_client 래퍼.
+
+    Parameters
+    ----------
+    num_robots : 로봇 수 (로봇 i → base_port + i)
+    host       : UE5 실행 PC IP
+    base_port  : 첫 로봇의 HexapodNetworkComponent ListenPort
+    encoding   : 'text' 또는 'q16'
+    timeout_ms : step() 응답 대기 시간
+    lib_path   : 공유 라이브러리 경로 (기본: HEXAPOD_CLIENT_LIB / Client/Build)
+    """
+
+    def __init__(
+        self,
+        num_robots: int = 1,
+        host: str = '127.0.0.1',
+        base_port: int = 7777,
+        encoding: str = 'text',
+        timeout_ms: int = 100,
+        lib_path: Optional[str] = None,
+    ):
+        self._handle = None   # 생성 도중 예외가 나도 close()/__del__ 가 안전하도록 먼저
+        self.num_robots = num_robots
+        self.timeout_ms = timeout_ms
+        self._lib = _load_library(lib_path or _default_library_path())
+        self._handle = self._lib.hexapod_client_create(
+            host.encode(), base_port, num_robots, ENCODINGS[encoding.lower()])
+        if not self._handle:
+            raise OSError(f"hexapod_client_create 실패: {host}:{base_port} × {num_robots}")
+
+        # 결과 버퍼는 1회 할당 후 재사용 → step() 마다 C 가 직접 기록
+        self._obs    = np.zeros((num_robots, OBS_SIZE), dtype=np.float32)
+        self._counts = np.zeros(num_robots, dtype=np.uint32)
+        self._seqs   = np.zeros(num_robots, dtype=np.uint32)
+        self._feet   = np.zeros((num_robots, FOOT_SIZE), dtype=np.float32)
+        self._feet_counts = np.zeros(num_robots, dtype=np.uint32)
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # 배치 스텝
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def step(self, actions: np.ndarray, out: Optional[np.ndarray] = None) -> np.ndarray:
+        """
+        모든 로봇에 JOINTS 송신 후 응답을 모아 반환.
+
+        Args:
+            actions: (N, 18) 관절 목표 각도 (도)
+            out:     (N, 24) float32 결과 버퍼 (없으면 내부 버퍼 사용)
+
+        Returns:
+            (N, 24) 관측값 — 응답이 없던 로봇은 직전 값 유지
+        """
+        actions = _as_f32(actions, (self.num_robots, NUM_JOINTS), 'actions')
+        obs = self._obs if out is None else out
+        if obs.dtype != np.float32 or not obs.flags['C_CONTIGUOUS'] or obs.shape != (self.num_robots, OBS_SIZE):
+            raise ValueError("out 은 (N, 24) float32 C-contiguous 배열이어야 합니다.")
+        self.last_replied = self._lib.hexapod_client_step(
+            self._handle, actions.ctypes.data_as(_F32_P), obs.ctypes.data_as(_F32_P), self.timeout_ms)
+        return obs
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # 파이프라인 (논블로킹)
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def send_joints(self, actions: np.ndarray, mask: Optional[np.ndarray] = None) -> int:
+        actions = _as_f32(actions, (self.num_robots, NUM_JOINTS), 'actions')
+        return self._lib.hexapod_client_send_joints(self._handle, actions.ctypes.data_as(_F32_P), self._mask(mask))
+
+    def send_input(self, inputs: np.ndarray, mask: Optional[np.ndarray] = None) -> int:
+        inputs = _as_f32(inputs, (self.num_robots, 2), 'inputs')
+        return self._lib.hexapod_client_send_input(self._handle, inputs.ctypes.data_as(_F32_P), self._mask(mask))
+
+    def send_command(self, command: str, mask: Optional[np.ndarray] = None) -> int:
+        """임의 명령 (예: 'RESET', 'OBS_REQ') 을 로봇들에 송신."""
+        return self._lib.hexapod_client_send_command(self._handle, command.encode(), self._mask(mask))
+
+    def poll(self, timeout_ms: int = 0) -> int:
+        """도착한 응답을 처리. 반환: 새로 받은 관측값 수."""
+        return self._lib.hexapod_client_poll(self._handle, timeout_ms)
+
+    def latest(self) -> Tuple[np.ndarray, np.ndarray]:
+        """(N, 24) 최신 관측값과 (N,) 로봇별 누적 수신 횟수."""
+        self._lib.hexapod_client_latest(
+            self._handle, self._obs.ctypes.data_as(_F32_P), self._counts.ctypes.data_as(_U32_P))
+        return self._obs, self._counts
+
+    def in_flight(self, robot: int) -> int:
+        return self._lib.hexapod_client_in_flight(self._handle, robot)
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # 발끝 FK (TEXT 인코딩)
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def set_feet(self, enabled: bool) -> int:
+        """이후 TEXT 관측에 발끝 필드 21 개를 붙이도록 요청 (기본 꺼짐, Q16 은 지원 안 함)."""
+        return self._lib.hexapod_client_feet(self._handle, 1 if enabled else 0)
+
+    def latest_feet(self) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        (N, 21) 최신 발끝 필드와 (N,) FEET 가 붙은 관측 수.
+        열: 발끝 xyz × 6 (몸통 좌표계 cm), 접지 비트마스크, 안정 여유 (cm), 지지 넓이 (cm²)
+        """
+        self._lib.hexapod_client_latest_feet(
+            self._handle, self._feet.ctypes.data_as(_F32_P), self._feet_counts.ctypes.data_as(_U32_P))
+        return self._feet, self._feet_counts
+
+    # ─────────────────────────────────────────────────────────────────────────
+    # 파이프라인 스텝 (행동/관측 순번 태그)
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def pipeline(self, depth: int, hold: str = 'last') -> int:
+        """
+        파이프라인 스텝 켜기 (depth=0 이면 요청/응답으로 복귀).
+
+        Args:
+            depth: 허용 지연 스텝 수 — step_pipelined() 는 관측이 depth 스텝 전 행동까지 반영했으면 바로 반환
+            hold:  'last' (마지막 행동 유지) 또는 'stand' (depth 를 넘게 행동이 없으면 서있는 자세)
+        """
+        return self._lib.hexapod_client_pipeline(self._handle, depth, HOLD_POLICIES[hold.lower()])
+
+    def step_pipelined(self, actions: np.ndarray, out: Optional[np.ndarray] = None) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        순번 붙은 행동을 보내고, 허용 지연 안의 최신 관측을 반환.
+
+        Returns:
+            ((N, 24) 관측값, (N,) uint32 각 관측이 반영한 행동 순번 — 1 부터 step_pipelined 호출 순)
+        """
+        actions = _as_f32(actions, (self.num_robots, NUM_JOINTS), 'actions')
+        obs = self._obs if out is None else out
+        if obs.dtype != np.float32 or not obs.flags['C_CONTIGUOUS'] or obs.shape != (self.num_robots, OBS_SIZE):
+            raise ValueError("out 은 (N, 24) float32 C-contiguous 배열이어야 합니다.")
+        self.last_replied = self._lib.hexapod_client_step_pipelined(
+            self._handle, actions.ctypes.data_as(_F32_P), obs.ctypes.data_as(_F32_P),
+            self._seqs.ctypes.data_as(_U32_P), self.timeout_ms)
+        return obs, self._seqs
+
+    # ─────────────────────────────────────────────────────────────────────────
+
+    def close(self):
+        if self._handle:
+            self._lib.hexapod_client_destroy(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+    def _mask(self, mask: Optional[np.ndarray]):
+        if mask is None:
+            return None
+        mask = np.ascontiguousarray(mask, dtype=np.uint8)
+        if mask.shape != (self.num_robots,):
+            raise ValueError(f"mask shape 은 ({self.num_robots},) 여야 합니다.")
+        self._mask_keepalive = mask
+        return mask.ctypes.data_as(_U8_P)
@@ -9,6 +9,8 @@ Pico는 각도 → 서보 펄스 변환만 수행.
 
 == 수신 프로토콜 (USB 시리얼 or UART) ==
     "JOINTS a0 a1 ... a17\\n"   → 18개 관절 각도 적용
+    "PULSES p0 p1 ... p17\\n"   → 18개 펄스폭(μs) 그대로 적용
+                                 (UE5 HexapodSerialBridgeComponent 가 변환 후 전송)
     "RESET\\n"                  → 모든 서보 중앙(avg) 위치로 복귀
 
 == 응답 ==
@@ -151,6 +153,17 @@ def apply_joint_angles(angles):
             send_pulse(calibration[key]['pin'], pulse)
 
 
+def apply_joint_pulses(pulses):
+    """UE5 관절 순서(Leg0 Hip ~ Leg5 Calf)의 펄스폭 18개를 서보에 적용."""
+    if len(pulses) != 18:
+        return
+    for leg_idx in range(6):
+        leg_name = UE5_TO_REAL_LEG[leg_idx]
+        for joint_idx in range(3):
+            key = leg_name + str(joint_idx + 1)
+            send_pulse(calibration[key]['pin'], pulses[leg_idx * 3 + joint_idx])
+
+
 # ─────────────────────────────────────────────────────────────────────────────
 # 명령 파싱 및 처리
 # ─────────────────────────────────────────────────────────────────────────────
@@ -161,6 +174,7 @@ def process_command(line):
 
     지원 명령:
         "JOINTS a0 a1 ... a17"  → 18개 각도 적용
+        "PULSES p0 p1 ... p17"  → 18개 펄스폭 적용
         "RESET"                 → 서있는 자세 복귀
 
     Returns:
@@ -180,6 +194,13 @@ def process_command(line):
         except ValueError:
             return 'ERR'
 
+    elif cmd == 'PULSES' and len(parts) == 19:
+        try:
+            apply_joint_pulses([int(x) for x in parts[1:]])
+            return 'OK'
+        except ValueError:
+            return 'ERR'
+
     elif cmd == 'RESET':
         center_all()
         return 'OK'
@@ -195,7 +216,7 @@ def main():
     init_servos()
     center_all()
     print("=== Hexapod Pico Controller ===")
-    print("Protocol: JOINTS a0..a17 | RESET")
+    print("Protocol: JOINTS a0..a17 | PULSES p0..p17 | RESET")
     print("Listening on USB serial...")
 
     buf = ''
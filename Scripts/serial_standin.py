@@ -0,0 +1,93 @@
+"""
+serial_standin.py — Pico 대역 가상 시리얼 포트 (Linux / macOS)
+
+실제 하드웨어 없이 UE5 HexapodSerialBridgeComponent 를 시험하기 위한 도구.
+가상 터미널(pty)을 열고 robot_pico.py 와 같은 방식으로 한 줄씩 받아 "OK"/"ERR" 응답.
+수신 주기(평균/지터)와 마지막 펄스값을 1초마다 출력.
+
+== 사용법 ==
+    python serial_standin.py
+    → "[standin] 장치 경로: /dev/pts/5" 출력
+    → UE5 HexapodRobot 의 SerialBridgeComponent.DevicePath 에 해당 경로 입력 후 Play
+
+== 검사 항목 ==
+    PULSES 18개, 각 값 MIN_PULSE~MAX_PULSE 범위 (robot_pico.py 와 동일)
+"""
+
+import os
+import select
+import statistics
+import time
+import tty
+
+MIN_PULSE = 600
+MAX_PULSE = 2200
+
+
+def check_command(line: str) -> bool:
+    parts = line.split()
+    if not parts:
+        return False
+    cmd = parts[0].upper()
+    if cmd == 'PULSES' and len(parts) == 19:
+        try:
+            return all(MIN_PULSE <= int(p) <= MAX_PULSE for p in parts[1:])
+        except ValueError:
+            return False
+    if cmd == 'JOINTS' and len(parts) == 19:
+        try:
+            [float(x) for x in parts[1:]]
+            return True
+        except ValueError:
+            return False
+    return cmd == 'RESET'
+
+
+def main():
+    master, slave = os.openpty()
+    tty.setraw(slave)
+    print(f"[standin] 장치 경로: {os.ttyname(slave)}")
+
+    buf = b''
+    stamps = []
+    last_line = ''
+    lines = 0
+    errors = 0
+    report_at = time.monotonic() + 1.0
+
+    try:
+        while True:
+            ready, _, _ = select.select([master], [], [], 0.1)
+            if ready:
+                buf += os.read(master, 4096)
+                while b'\n' in buf:
+                    raw, buf = buf.split(b'\n', 1)
+                    line = raw.decode(errors='replace').strip()
+                    ok = check_command(line)
+                    errors += 0 if ok else 1
+                    os.write(master, b'OK\n' if ok else b'ERR\n')
+                    stamps.append(time.monotonic())
+                    last_line = line
+                    lines += 1
+
+            now = time.monotonic()
+            if now >= report_at:
+                report_at = now + 1.0
+                if len(stamps) >= 2:
+                    gaps = [(b - a) * 1000.0 for a, b in zip(stamps, stamps[1:])]
+                    print(f"[standin] {lines} 줄/s, 간격 평균 {statistics.mean(gaps):.2f} ms "
+                          f"(표준편차 {statistics.pstdev(gaps):.2f} ms), ERR {errors}")
+                    print(f"          마지막: {last_line[:120]}")
+                elif lines:
+                    print(f"[standin] {lines} 줄/s, ERR {errors}")
+                stamps = stamps[-1:]
+                lines = 0
+    except KeyboardInterrupt:
+        print("\n[standin] 종료")
+    finally:
+        os.close(master)
+        os.close(slave)
+
+
+if __name__ == '__main__':
+    main()
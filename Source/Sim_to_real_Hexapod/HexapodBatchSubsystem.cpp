@@ -0,0 +1,482 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodBatchSubsystem.h"
+#include "HexapodRobot.h"
+#include "HexapodNetworkComponent.h"
+#include "HexapodSensorComponent.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+// 로봇 수가 이보다 적으면 작업 분배 비용이 더 커서 게임 스레드에서 바로 계산
+static TAutoConsoleVariable<int32> CVarBatchMinParallel(
+	TEXT("Hexapod.Batch.MinParallel"), 8,
+	TEXT("이 수 이상의 로봇부터 배치 계산을 ParallelFor 로 분산"));
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 틱 함수
+// ─────────────────────────────────────────────────────────────────────────────
+
+void FHexapodBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                            const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (!Target || TickType == LEVELTICK_ViewportsOnly) return;
+
+	if (bPostPhysics)
+		Target->PostPhysicsUpdate(DeltaTime);
+	else
+		Target->PrePhysicsUpdate(DeltaTime);
+}
+
+FString FHexapodBatchTickFunction::DiagnosticMessage()
+{
+	return bPostPhysics ? TEXT("UHexapodBatchSubsystem[PostPhysics]") : TEXT("UHexapodBatchSubsystem[PrePhysics]");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 생명주기
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodBatchSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// 에디터 프리뷰 월드 등에는 만들지 않음
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UHexapodBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	PrePhysicsTick.Target        = this;
+	PrePhysicsTick.bPostPhysics  = false;
+	PrePhysicsTick.TickGroup     = TG_PrePhysics;
+	PrePhysicsTick.bCanEverTick  = true;
+	PrePhysicsTick.bStartWithTickEnabled = true;
+	PrePhysicsTick.RegisterTickFunction(InWorld.PersistentLevel);
+
+	PostPhysicsTick.Target       = this;
+	PostPhysicsTick.bPostPhysics = true;
+	PostPhysicsTick.TickGroup    = TG_PostPhysics;
+	PostPhysicsTick.bCanEverTick = true;
+	PostPhysicsTick.bStartWithTickEnabled = true;
+	PostPhysicsTick.RegisterTickFunction(InWorld.PersistentLevel);
+
+	// 보행 중인 로봇이 생길 때까지 PrePhysics 는 쉼
+	PrePhysicsTick.SetTickFunctionEnable(ActiveList.Num() > 0 || bActiveListDirty);
+}
+
+void UHexapodBatchSubsystem::Deinitialize()
+{
+	if (PrePhysicsTick.IsTickFunctionRegistered())  PrePhysicsTick.UnRegisterTickFunction();
+	if (PostPhysicsTick.IsTickFunctionRegistered()) PostPhysicsTick.UnRegisterTickFunction();
+	Super::Deinitialize();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 등록 / 해제 (스왑 제거로 배열을 항상 빈틈없이 유지)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBatchSubsystem::RegisterRobot(AHexapodRobot* Robot)
+{
+	if (!Robot || Robot->BatchIndex != INDEX_NONE) return;
+
+	const int32 Index = Robots.Add(Robot);
+	Robot->BatchIndex = Index;
+	Movements.Add(Robot->MovementComponent);
+	ResizeArrays(Robots.Num());
+	EvalSteps[Index]   = 0;
+	ActiveFlags[Index] = 0;
+
+	// 보행은 배치에서 계산 → 컴포넌트 틱 끔
+	if (Robot->MovementComponent)
+	{
+		Robot->MovementComponent->SetBatched(true);
+		SetActiveFlag(Index, ActiveWalking, Robot->MovementComponent->IsWalking());
+	}
+
+	// 입력(컨트롤러)과 네트워크 명령이 먼저 반영된 뒤 보행 계산
+	if (Robot->Controller)
+		AddInputSource(Robot->Controller);
+	if (Robot->NetworkComponent)
+		PrePhysicsTick.AddPrerequisite(Robot->NetworkComponent, Robot->NetworkComponent->PrimaryComponentTick);
+
+	// 센서는 이번 물리 스텝의 관절 각도 캐시가 채워진 뒤 기록
+	if (Robot->SensorComponent)
+		Robot->SensorComponent->PrimaryComponentTick.AddPrerequisite(this, PostPhysicsTick);
+}
+
+void UHexapodBatchSubsystem::UnregisterRobot(AHexapodRobot* Robot)
+{
+	if (!Robot || !Robots.IsValidIndex(Robot->BatchIndex) || Robots[Robot->BatchIndex] != Robot) return;
+
+	if (Robot->Controller)
+		RemoveInputSource(Robot->Controller);
+	if (Robot->NetworkComponent)
+		PrePhysicsTick.RemovePrerequisite(Robot->NetworkComponent, Robot->NetworkComponent->PrimaryComponentTick);
+	if (Robot->SensorComponent)
+		Robot->SensorComponent->PrimaryComponentTick.RemovePrerequisite(this, PostPhysicsTick);
+	if (Robot->MovementComponent)
+		Robot->MovementComponent->SetBatched(false);
+
+	RemoveAtSwap(Robot->BatchIndex);
+	Robot->BatchIndex = INDEX_NONE;
+	bActiveListDirty = true;
+}
+
+void UHexapodBatchSubsystem::AddInputSource(AActor* Source)
+{
+	if (Source)
+		PrePhysicsTick.AddPrerequisite(Source, Source->PrimaryActorTick);
+}
+
+void UHexapodBatchSubsystem::RemoveInputSource(AActor* Source)
+{
+	if (Source)
+		PrePhysicsTick.RemovePrerequisite(Source, Source->PrimaryActorTick);
+}
+
+void UHexapodBatchSubsystem::ResizeArrays(int32 Num)
+{
+	GaitParams.SetNum(Num);
+	GaitInputs.SetNum(Num);
+	GaitPhases.SetNum(Num);
+	TargetModes.SetNum(Num);
+	Targets.SetNum(Num * 18);
+
+	BodyQuats.SetNum(Num * HexapodBatchBodies);
+	RootVelocities.SetNum(Num);
+	JointAngles.SetNum(Num * 18);
+	FootObs.SetNum(Num * HexapodKinematics::FootFields);
+	Rewards.SetNum(Num);
+	EvalSteps.SetNum(Num);
+	ActiveFlags.SetNum(Num);
+}
+
+// 로봇 단위 블록(Stride 개)을 마지막 로봇 블록으로 덮어씀
+template<typename T>
+static void RemoveBlockAtSwap(TArray<T>& Array, int32 Index, int32 Last, int32 Stride)
+{
+	if (Index != Last)
+		FMemory::Memcpy(&Array[Index * Stride], &Array[Last * Stride], sizeof(T) * Stride);
+	Array.SetNum(Last * Stride, false);
+}
+
+void UHexapodBatchSubsystem::RemoveAtSwap(int32 Index)
+{
+	const int32 Last = Robots.Num() - 1;
+
+	Robots.RemoveAtSwap(Index, 1, false);
+	Movements.RemoveAtSwap(Index, 1, false);
+	if (Robots.IsValidIndex(Index))
+		Robots[Index]->BatchIndex = Index;
+
+	RemoveBlockAtSwap(GaitParams,     Index, Last, 1);
+	RemoveBlockAtSwap(GaitInputs,     Index, Last, 1);
+	RemoveBlockAtSwap(GaitPhases,     Index, Last, 1);
+	RemoveBlockAtSwap(TargetModes,    Index, Last, 1);
+	RemoveBlockAtSwap(Targets,        Index, Last, 18);
+	RemoveBlockAtSwap(BodyQuats,      Index, Last, HexapodBatchBodies);
+	RemoveBlockAtSwap(RootVelocities, Index, Last, 1);
+	RemoveBlockAtSwap(JointAngles,    Index, Last, 18);
+	RemoveBlockAtSwap(FootObs,        Index, Last, HexapodKinematics::FootFields);
+	RemoveBlockAtSwap(Rewards,        Index, Last, 1);
+	RemoveBlockAtSwap(EvalSteps,      Index, Last, 1);
+	RemoveBlockAtSwap(ActiveFlags,    Index, Last, 1);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 활성 목록 — 바뀔 때만 다시 만들고, 비면 PrePhysics 틱을 끔
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBatchSubsystem::SetRobotWalking(int32 Index, bool bWalking)
+{
+	if (!ActiveFlags.IsValidIndex(Index)) return;
+
+	SetActiveFlag(Index, ActiveWalking, bWalking);
+	// 멈춘 직후 한 번은 서있는 자세로 복귀
+	SetActiveFlag(Index, ActiveSettle, !bWalking);
+}
+
+void UHexapodBatchSubsystem::SetRobotActive(int32 Index, bool bActive)
+{
+	if (ActiveFlags.IsValidIndex(Index))
+		SetActiveFlag(Index, ActiveExternal, bActive);
+}
+
+void UHexapodBatchSubsystem::SetActiveFlag(int32 Index, uint8 Flag, bool bSet)
+{
+	const uint8 Old = ActiveFlags[Index];
+	const uint8 New = bSet ? (Old | Flag) : (Old & ~Flag);
+	if (Old == New) return;
+
+	ActiveFlags[Index] = New;
+	if ((Old != 0) != (New != 0))
+	{
+		bActiveListDirty = true;
+		PrePhysicsTick.SetTickFunctionEnable(true);
+	}
+}
+
+void UHexapodBatchSubsystem::RebuildActiveList()
+{
+	ActiveList.Reset();
+	for (int32 i = 0; i < ActiveFlags.Num(); i++)
+		if (ActiveFlags[i]) ActiveList.Add(i);
+	bActiveListDirty = false;
+}
+
+void UHexapodBatchSubsystem::InvalidateRobot(int32 Index)
+{
+	if (EvalSteps.IsValidIndex(Index))
+		EvalSteps[Index] = 0;
+}
+
+bool UHexapodBatchSubsystem::CopyJointAngles(int32 Index, float* OutAngles)
+{
+	if (!EvalSteps.IsValidIndex(Index)) return false;
+	if (EvalSteps[Index] != PhysicsStep) EvaluateRobot(Index);
+
+	FMemory::Memcpy(OutAngles, &JointAngles[Index * 18], sizeof(float) * 18);
+	return true;
+}
+
+bool UHexapodBatchSubsystem::CopyFootObservation(int32 Index, float* OutFields)
+{
+	if (!EvalSteps.IsValidIndex(Index)) return false;
+	if (EvalSteps[Index] != PhysicsStep) EvaluateRobot(Index);
+
+	FMemory::Memcpy(OutFields, &FootObs[Index * HexapodKinematics::FootFields], sizeof(float) * HexapodKinematics::FootFields);
+	return true;
+}
+
+float UHexapodBatchSubsystem::GetReward(int32 Index)
+{
+	if (!EvalSteps.IsValidIndex(Index)) return 0.f;
+	if (EvalSteps[Index] != PhysicsStep) EvaluateRobot(Index);
+	return Rewards[Index];
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// TG_PrePhysics: 보행 목표각도 (활성 로봇만)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBatchSubsystem::PrePhysicsUpdate(float DeltaTime)
+{
+	if (bActiveListDirty) RebuildActiveList();
+
+	const int32 Num = ActiveList.Num();
+	if (Num == 0)
+	{
+		PrePhysicsTick.SetTickFunctionEnable(false);
+		return;
+	}
+
+	// 1) 수집 (게임 스레드): 입력 + 위상 진행
+	double T0 = FPlatformTime::Seconds();
+	for (int32 k = 0; k < Num; k++)
+	{
+		const int32 i = ActiveList[k];
+		UHexapodMovementComponent* Movement = Movements[i];
+		TargetModes[i] = TargetKeep;
+		if (!Movement) continue;
+
+		if (Movement->IsWalking())
+		{
+			TargetModes[i] = TargetGait;
+			GaitInputs[i]  = Movement->GetInputDirection();
+			GaitParams[i]  = Movement->GetGaitParams();
+			Movement->SetGaitPhase(FMath::Fmod(Movement->GetGaitPhase() + DeltaTime * GaitParams[i].WalkSpeed, 1.0f));
+			GaitPhases[i]  = Movement->GetGaitPhase();
+		}
+		else if (ActiveFlags[i] & ActiveSettle)
+		{
+			TargetModes[i] = TargetStand;
+			SetActiveFlag(i, ActiveSettle, false);
+		}
+	}
+
+	// 2) 계산 (병렬): 로봇 하나당 18개, 공유 상태 없음
+	double T1 = FPlatformTime::Seconds();
+	ParallelFor(Num, [this](int32 k)
+	{
+		const int32 i = ActiveList[k];
+		float* Out = &Targets[i * 18];
+		if (TargetModes[i] == TargetGait)
+			UHexapodMovementComponent::ComputeGaitTargets(GaitParams[i], GaitInputs[i], GaitPhases[i], Out);
+		else if (TargetModes[i] == TargetStand)
+			UHexapodMovementComponent::ComputeStandingTargets(Out);
+	}, Num < CVarBatchMinParallel.GetValueOnGameThread());
+
+	// 3) 반영 (게임 스레드): 물리 관절 드라이브 목표
+	double T2 = FPlatformTime::Seconds();
+	for (int32 k = 0; k < Num; k++)
+	{
+		const int32 i = ActiveList[k];
+		if (TargetModes[i] != TargetKeep)
+			Robots[i]->SetConstraintTargets(&Targets[i * 18]);
+	}
+	double T3 = FPlatformTime::Seconds();
+
+	GatherMs  = (T1 - T0) * 1000.0;
+	ComputeMs = (T2 - T1) * 1000.0;
+	ScatterMs = (T3 - T2) * 1000.0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// TG_PostPhysics: 관절 각도 + 발끝 FK + 보상 (활성 로봇은 일괄, 유휴 로봇은 읽을 때)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBatchSubsystem::GatherBodies(int32 i)
+{
+	const AHexapodRobot* Robot = Robots[i];
+	const TArray<FHexapodLeg>& Legs = Robot->GetLegs();
+	FQuat4f* Quats = &BodyQuats[i * HexapodBatchBodies];
+
+	Quats[0] = FQuat4f(Robot->BodyMesh->GetComponentQuat());
+	for (int32 Leg = 0; Leg < 6; Leg++)
+	{
+		Quats[1 + Leg * 3 + 0] = FQuat4f(Legs[Leg].HipMesh->GetComponentQuat());
+		Quats[1 + Leg * 3 + 1] = FQuat4f(Legs[Leg].ThighMesh->GetComponentQuat());
+		Quats[1 + Leg * 3 + 2] = FQuat4f(Legs[Leg].CalfMesh->GetComponentQuat());
+	}
+	RootVelocities[i] = FVector3f(Robot->BodyMesh->GetPhysicsLinearVelocity());
+}
+
+void UHexapodBatchSubsystem::ComputeRobot(int32 i)
+{
+	const FQuat4f* Quats = &BodyQuats[i * HexapodBatchBodies];
+	float* Angles = &JointAngles[i * 18];
+	float FootAngles[18];
+
+	// AHexapodRobot::GetJointAngles 와 같은 정의: 부모 바디 기준 상대 회전의 Yaw
+	// FK 입력은 Thigh 만 Pitch (AHexapodRobot::GetFootJointAngles)
+	for (int32 Leg = 0; Leg < 6; Leg++)
+	{
+		const FQuat4f& Body  = Quats[0];
+		const FQuat4f& Hip   = Quats[1 + Leg * 3 + 0];
+		const FQuat4f& Thigh = Quats[1 + Leg * 3 + 1];
+		const FQuat4f& Calf  = Quats[1 + Leg * 3 + 2];
+		const FRotator3f ThighRel = (Hip.Inverse() * Thigh).Rotator();
+		Angles[Leg * 3 + 0] = (Body.Inverse()  * Hip).Rotator().Yaw;
+		Angles[Leg * 3 + 1] = ThighRel.Yaw;
+		Angles[Leg * 3 + 2] = (Thigh.Inverse() * Calf).Rotator().Yaw;
+
+		FootAngles[Leg * 3 + 0] = Angles[Leg * 3 + 0];
+		FootAngles[Leg * 3 + 1] = ThighRel.Pitch;
+		FootAngles[Leg * 3 + 2] = Angles[Leg * 3 + 2];
+	}
+
+	// 발끝 FK + 지지 다각형: 접지는 몸통 좌표계로 옮긴 중력 방향 기준
+	const FVector3f Down = Quats[0].UnrotateVector(FVector3f(0.f, 0.f, -1.f));
+	const float DownArr[3] = { Down.X, Down.Y, Down.Z };
+	float* Foot = &FootObs[i * HexapodKinematics::FootFields];
+	HexapodKinematics::ComputeFootObservation(LegGeometry, FootAngles, DownArr, Foot);
+	const float Margin = Foot[HexapodKinematics::NumLegs * 3 + 1];   // cm
+
+	// 몸통 전방 = 로컬 -Y (Leg2/Leg5 가 앞다리)
+	const FVector3f Forward = -Quats[0].GetAxisY();
+	const float     Speed   = FVector3f::DotProduct(RootVelocities[i], Forward) * 0.01f;   // cm/s → m/s
+	const FRotator3f Attitude = Quats[0].Rotator();
+	const float Roll  = FMath::DegreesToRadians(Attitude.Roll);
+	const float Pitch = FMath::DegreesToRadians(Attitude.Pitch);
+	Rewards[i] = Speed - TiltPenalty * (Roll * Roll + Pitch * Pitch)
+	           - StabilityPenalty * FMath::Max(0.f, -Margin) * 0.01f;
+
+	EvalSteps[i] = PhysicsStep;
+}
+
+void UHexapodBatchSubsystem::EvaluateRobot(int32 i)
+{
+	GatherBodies(i);
+	ComputeRobot(i);
+}
+
+void UHexapodBatchSubsystem::PostPhysicsUpdate(float DeltaTime)
+{
+	// 물리 스텝이 하나 지났으므로 이전 캐시는 모두 무효
+	PhysicsStep++;
+
+	if (bActiveListDirty) RebuildActiveList();
+	const int32 Num = ActiveList.Num();
+	if (Num == 0)
+	{
+		PostBatchDelegate.Broadcast(DeltaTime);
+		return;
+	}
+
+	// 1) 수집 (게임 스레드)
+	double T0 = FPlatformTime::Seconds();
+	for (int32 k = 0; k < Num; k++)
+		GatherBodies(ActiveList[k]);
+
+	// 2) 계산 (병렬)
+	double T1 = FPlatformTime::Seconds();
+	ParallelFor(Num, [this](int32 k)
+	{
+		ComputeRobot(ActiveList[k]);
+	}, Num < CVarBatchMinParallel.GetValueOnGameThread());
+	double T2 = FPlatformTime::Seconds();
+
+	GatherMs  += (T1 - T0) * 1000.0;
+	ComputeMs += (T2 - T1) * 1000.0;
+
+	// 3) 후처리 구독자 — 이번 스텝 캐시가 모두 채워진 뒤
+	PostBatchDelegate.Broadcast(DeltaTime);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 헤드리스 로봇 스폰
+// ─────────────────────────────────────────────────────────────────────────────
+
+UClass* UHexapodBatchSubsystem::GetRobotClass() const
+{
+	for (const AHexapodRobot* Robot : Robots)
+		if (IsValid(Robot)) return Robot->GetClass();
+	return AHexapodRobot::StaticClass();
+}
+
+AHexapodRobot* UHexapodBatchSubsystem::SpawnHeadlessRobot(UClass* Class, const FTransform& Transform)
+{
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	AHexapodRobot* Robot = World->SpawnActorDeferred<AHexapodRobot>(Class ? Class : GetRobotClass(), Transform, nullptr, nullptr,
+	                                                                ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Robot) return nullptr;
+
+	if (UHexapodNetworkComponent* Network = Robot->FindComponentByClass<UHexapodNetworkComponent>())
+		Network->ListenPort = 0;
+	Robot->FinishSpawning(Transform);
+
+	float Standing[18];
+	UHexapodMovementComponent::ComputeStandingTargets(Standing);
+	Robot->SetConstraintTargets(Standing);
+	return Robot;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 콘솔 명령: Hexapod.BatchStats
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBatchSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("HexapodBatch: 로봇 %d 대 (활성 %d), 수집 %.3f ms, 계산 %.3f ms, 반영 %.3f ms (병렬 기준 %d 대)"),
+	       Robots.Num(), ActiveList.Num(), GatherMs, ComputeMs, ScatterMs, CVarBatchMinParallel.GetValueOnGameThread());
+
+	const int32 Shown = FMath::Min(Robots.Num(), 8);
+	for (int32 i = 0; i < Shown; i++)
+	{
+		const float* Foot = &FootObs[i * HexapodKinematics::FootFields + HexapodKinematics::NumLegs * 3];
+		UE_LOG(LogTemp, Log, TEXT("  [%d] %s  활성 0x%x  보상 %.3f  접지 0x%02x  안정 여유 %.1f cm  지지 %.0f cm² (스텝 %u)"),
+		       i, *GetNameSafe(Robots[i]), ActiveFlags[i], Rewards[i], (uint32)Foot[0], Foot[1], Foot[2], EvalSteps[i]);
+	}
+}
+
+static FAutoConsoleCommandWithWorld GHexapodBatchStatsCmd(
+	TEXT("Hexapod.BatchStats"),
+	TEXT("배치 갱신 로봇 수, 구간별 시간, 로봇별 보상 출력"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UHexapodBatchSubsystem* Batch = World ? World->GetSubsystem<UHexapodBatchSubsystem>() : nullptr)
+			Batch->LogStats();
+	}));
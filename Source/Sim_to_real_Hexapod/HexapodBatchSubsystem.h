@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HexapodMovementComponent.h"
+#include "HexapodKinematics.h"
+#include "HexapodBatchSubsystem.generated.h"
+
+class AHexapodRobot;
+class UHexapodBatchSubsystem;
+
+/** 관절 각도 계산에 쓰는 바디 수 (몸통 1 + 다리 6 × Hip/Thigh/Calf 메시) */
+constexpr int32 HexapodBatchBodies = 19;
+
+/** 배치 PostPhysics 계산이 끝난 직후 (DeltaTime) — 스윕/데이터셋/프로파일 등 물리 스텝 단위 후처리 */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHexapodPostBatch, float);
+
+/**
+ * 배치 서브시스템 전용 틱 함수.
+ * 같은 구조체를 PrePhysics(보행 목표) / PostPhysics(관절 각도·보상) 두 번 등록해 사용.
+ */
+USTRUCT()
+struct FHexapodBatchTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UHexapodBatchSubsystem* Target = nullptr;
+	bool bPostPhysics = false;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHexapodBatchTickFunction> : public TStructOpsTypeTraitsBase2<FHexapodBatchTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * UHexapodBatchSubsystem
+ *
+ * 월드의 모든 AHexapodRobot 을 한 번에 갱신.
+ * 로봇마다 컴포넌트 틱을 돌며 트랜스폼을 하나씩 읽는 대신,
+ * 필요한 값을 로봇 순서대로 연속 배열(SoA)에 모은 뒤 ParallelFor 로 계산하고 결과만 되돌려 씀.
+ *
+ *  TG_PrePhysics  : 입력/위상 수집 → [병렬] 보행 목표각도 18개 → 관절 드라이브 반영 (직렬)
+ *  TG_PostPhysics : 바디 회전 19개 + 루트 위치/속도 수집 → [병렬] 관절 각도 18개 → 발끝 FK + 지지 다각형 → 보상
+ *
+ * 활성 로봇(보행 중 / SetRobotActive)만 매 스텝 일괄 계산. 나머지는 깨어 있을 이유가 없음:
+ *  - 보행이 멈추면 다음 PrePhysics 에 서있는 자세를 한 번만 반영하고 목록에서 빠짐
+ *  - 활성 로봇이 없으면 PrePhysics 틱 자체를 끔 (PostPhysics 는 스텝 카운터만 올림)
+ *  - 유휴 로봇의 관절 각도/보상은 누군가 읽을 때 그 로봇만 계산 (스텝당 최대 1회)
+ *
+ * 물리 스텝 단위로 결과를 읽는 기능(스윕/데이터셋/프로파일)은 자기 틱 함수 대신 OnPostBatch 에 등록:
+ *  스텝 카운터와 일괄 계산이 끝난 뒤 같은 틱 안에서 호출되고, 콜백 안에서 등록 해제/로봇 스폰·제거 가능.
+ *
+ * 관절 각도 캐시는 물리 스텝 직후 계산되므로 다음 물리 스텝 전까지 AHexapodRobot::GetJointAngles 가 그대로 사용.
+ * 보상 = 몸통 전방 속도 (m/s) - TiltPenalty × (roll² + pitch²) (rad) - StabilityPenalty × max(0, -안정 여유) (m)
+ */
+UCLASS()
+class SIM_TO_REAL_HEXAPOD_API UHexapodBatchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/** AHexapodRobot::BeginPlay / EndPlay 에서 호출 */
+	void RegisterRobot(AHexapodRobot* Robot);
+	void UnregisterRobot(AHexapodRobot* Robot);
+
+	/** 컨트롤러 입력이 보행 계산보다 먼저 처리되도록 (AHexapodRobot::PossessedBy / UnPossessed) */
+	void AddInputSource(AActor* Source);
+	void RemoveInputSource(AActor* Source);
+
+	/** 보행 시작/정지 — UHexapodMovementComponent 입력 변화 시 호출 */
+	void SetRobotWalking(int32 Index, bool bWalking);
+
+	/** 외부(스윕 등)에서 유휴 상태와 무관하게 매 스텝 일괄 계산에 포함 */
+	void SetRobotActive(int32 Index, bool bActive);
+
+	/** 텔레포트/상태 복원 등으로 캐시가 무효해졌을 때 (다음에 읽을 때 다시 계산) */
+	void InvalidateRobot(int32 Index);
+
+	/** 이번 물리 스텝 기준 관절 각도 18개 (캐시가 없으면 이 로봇만 계산). 미등록이면 false */
+	bool CopyJointAngles(int32 Index, float* OutAngles);
+
+	/** 발끝 위치 + 접지 마스크 + 안정 여유 + 지지 넓이 (HexapodKinematics::FootFields 개, 관절 각도와 같은 캐시) */
+	bool CopyFootObservation(int32 Index, float* OutFields);
+
+	float GetReward(int32 Index);
+	int32 GetNumRobots() const { return Robots.Num(); }
+	int32 GetNumActive() const { return ActiveList.Num(); }
+	AHexapodRobot* GetRobot(int32 Index) const { return Robots[Index]; }
+
+	/** 관절 목표를 직접 쓰는 PrePhysics 틱은 이 틱을 선행 조건으로 (배치 반영이 덮어쓰지 않도록) */
+	FTickFunction& GetPrePhysicsTick() { return PrePhysicsTick; }
+
+	/** 관측을 읽는 PostPhysics 틱은 이 틱을 선행 조건으로 (스텝 카운터 / 일괄 계산 완료 보장) */
+	FTickFunction& GetPostPhysicsTick() { return PostPhysicsTick; }
+
+	/** 매 물리 스텝 배치 PostPhysics 계산 직후 호출 (활성 로봇이 없어도) */
+	FOnHexapodPostBatch& OnPostBatch() { return PostBatchDelegate; }
+
+	/** 맵에 배치된 첫 로봇의 클래스 (Blueprint 메시 포함), 없으면 AHexapodRobot */
+	UClass* GetRobotClass() const;
+
+	/**
+	 * 헤드리스 작업(스윕/프로파일)용 로봇 스폰: UDP 포트를 열지 않고(조작 중인 로봇과 포트 충돌 방지)
+	 * 서있는 자세 목표로 시작. Class 가 nullptr 이면 GetRobotClass()
+	 */
+	AHexapodRobot* SpawnHeadlessRobot(UClass* Class, const FTransform& Transform);
+
+	/** 기울기 벌점 가중치 */
+	float TiltPenalty = 0.5f;
+
+	/** 몸통 원점이 지지 다각형 밖으로 나간 거리 (m) 벌점 가중치 */
+	float StabilityPenalty = 5.f;
+
+	/** 발끝 FK 다리 치수 (모든 로봇 공유) */
+	HexapodKinematics::FLegGeometry LegGeometry = HexapodKinematics::FLegGeometry::Default();
+
+	void PrePhysicsUpdate(float DeltaTime);
+	void PostPhysicsUpdate(float DeltaTime);
+
+	void LogStats() const;
+
+private:
+	UPROPERTY(Transient)
+	TArray<AHexapodRobot*> Robots;
+
+	UPROPERTY(Transient)
+	TArray<UHexapodMovementComponent*> Movements;
+
+	FHexapodBatchTickFunction PrePhysicsTick;
+	FHexapodBatchTickFunction PostPhysicsTick;
+	FOnHexapodPostBatch PostBatchDelegate;
+
+	// ── PrePhysics SoA (로봇 i) ─────────────────────────────
+	TArray<FHexapodGaitParams> GaitParams;
+	TArray<FVector2D>          GaitInputs;
+	TArray<float>              GaitPhases;
+	TArray<uint8>              TargetModes;      // 이번 스텝에 반영할 목표 (TargetKeep / Gait / Stand)
+	TArray<float>              Targets;          // i * 18 + j
+
+	// ── PostPhysics SoA ─────────────────────────────────────
+	TArray<FQuat4f>   BodyQuats;                 // i * 19 + (0 = 몸통, 1 + Leg * 3 + Joint)
+	TArray<FVector3f> RootVelocities;            // cm/s
+	TArray<float>     JointAngles;               // i * 18 + j (도)
+	TArray<float>     FootObs;                   // i * FootFields + f (HexapodKinematics 참고)
+	TArray<float>     Rewards;
+	TArray<uint32>    EvalSteps;                 // 관절 각도/보상을 계산한 물리 스텝 (== PhysicsStep 이면 유효)
+
+	// ── 활성 목록 ───────────────────────────────────────────
+	enum : uint8 { ActiveWalking = 1, ActiveExternal = 2, ActiveSettle = 4 };
+	enum : uint8 { TargetKeep = 0, TargetGait = 1, TargetStand = 2 };
+	TArray<uint8> ActiveFlags;
+	TArray<int32> ActiveList;                    // ActiveFlags != 0 인 로봇 인덱스
+	bool bActiveListDirty = false;
+
+	uint32 PhysicsStep = 1;
+
+	// 마지막 프레임 구간별 시간 (ms)
+	double GatherMs  = 0.0;
+	double ComputeMs = 0.0;
+	double ScatterMs = 0.0;
+
+	void ResizeArrays(int32 Num);
+	void RemoveAtSwap(int32 Index);
+	void SetActiveFlag(int32 Index, uint8 Flag, bool bSet);
+	void RebuildActiveList();
+
+	/** 게임 스레드: 바디 회전 19개 + 루트 속도 → SoA */
+	void GatherBodies(int32 Index);
+	/** 수집된 값 → 관절 각도 + 발끝 FK + 보상 (다른 로봇과 공유 상태 없음, 워커 스레드 가능) */
+	void ComputeRobot(int32 Index);
+	/** 유휴 로봇 단독 계산 (수집 + 계산) */
+	void EvaluateRobot(int32 Index);
+};
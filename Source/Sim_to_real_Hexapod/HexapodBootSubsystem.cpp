@@ -0,0 +1,226 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodBootSubsystem.h"
+#include "HexapodRobot.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/UdpSocketReceiver.h"
+
+static const TCHAR* const HexapodBootStageNames[] =
+{
+	TEXT("engine"), TEXT("map"), TEXT("meshes"), TEXT("spawn"), TEXT("first_step"),
+};
+static_assert(UE_ARRAY_COUNT(HexapodBootStageNames) == static_cast<int32>(EHexapodBootStage::Count),
+              "단계 이름 수가 EHexapodBootStage 와 다름");
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 생명주기
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBootSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (double& Time : StageTimes)
+		Time = -1.0;
+
+	const TCHAR* CmdLine = FCommandLine::Get();
+	bFastBoot      = FParse::Param(CmdLine, TEXT("HexapodFastBoot"));
+	bCollisionOnly = FParse::Param(CmdLine, TEXT("HexapodCollisionOnly"));
+	FParse::Value(CmdLine, TEXT("HexapodRobots="), NumRobots);
+	FParse::Value(CmdLine, TEXT("HexapodBasePort="), BasePort);
+	NumRobots = FMath::Clamp(NumRobots, 1, 256);
+	// 스케일링 측정(UHexapodProfileSubsystem)은 포트 없는 로봇을 직접 스폰 → 네트워크 로봇/조기 소켓 없음
+	int32 ProfileMaxRobots = 0;
+	if (FParse::Value(CmdLine, TEXT("HexapodProfile="), ProfileMaxRobots))
+		NumRobots = 0;
+
+	MarkStage(EHexapodBootStage::EngineInit);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UHexapodBootSubsystem::OnPostLoadMap);
+
+	if (!bFastBoot)
+		return;
+
+	// 1) 포트부터 열어 둠 → 클라이언트는 맵 로드 중에도 BOOTING 응답으로 살아 있음을 확인
+	OpenEarlyListeners();
+
+	// 2) 로봇 메시 비동기 로드 → 맵 로드와 겹침 (생성자 동기 로드 대신)
+	TArray<FSoftObjectPath> MeshPaths;
+	GetDefault<AHexapodRobot>()->GetMeshAssetPaths(MeshPaths);
+	MeshHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MeshPaths, FStreamableDelegate::CreateUObject(this, &UHexapodBootSubsystem::OnMeshesLoaded),
+		FStreamableManager::AsyncLoadHighPriority);
+	if (!MeshHandle.IsValid())
+		OnMeshesLoaded();
+
+	UE_LOG(LogTemp, Log, TEXT("HexapodBoot: 빠른 기동 — 로봇 %d 대, 포트 %d~%d%s"),
+	       NumRobots, BasePort, BasePort + NumRobots - 1, bCollisionOnly ? TEXT(", 충돌 전용") : TEXT(""));
+}
+
+void UHexapodBootSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	for (TUniquePtr<FEarlyListener>& Listener : EarlyListeners)
+		CloseListener(*Listener, true);
+	EarlyListeners.Reset();
+
+	if (MeshHandle.IsValid())
+	{
+		MeshHandle->CancelHandle();
+		MeshHandle.Reset();
+	}
+	MeshCallbacks.Reset();
+
+	Super::Deinitialize();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 기동 단계 기록
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBootSubsystem::MarkStage(EHexapodBootStage Stage)
+{
+	const int32 Index = static_cast<int32>(Stage);
+	if (StageTimes[Index] >= 0.0) return;
+
+	StageTimes[Index] = FPlatformTime::Seconds() - GStartTime;
+	if (Index > LastStage) LastStage = Index;   // BOOTING 응답용 (수신 스레드가 읽음)
+
+	if (Stage == EHexapodBootStage::FirstStep)
+		UE_LOG(LogTemp, Log, TEXT("HexapodBoot: 기동 완료 %s"), *GetBreakdown());
+}
+
+FString UHexapodBootSubsystem::GetBreakdown() const
+{
+	// 단계별 추가 시간: 이전 단계들 중 가장 늦은 시각 이후만 셈 (맵 로드와 겹친 메시 로드 → 0)
+	FString Parts;
+	double Prev = 0.0;
+	for (int32 i = 0; i < static_cast<int32>(EHexapodBootStage::Count); i++)
+	{
+		const double Time = StageTimes[i] >= 0.0 ? StageTimes[i] : Prev;
+		Parts += FString::Printf(TEXT(" %s_ms=%.1f"), HexapodBootStageNames[i], FMath::Max(0.0, Time - Prev) * 1000.0);
+		Prev = FMath::Max(Prev, Time);
+	}
+	return FString::Printf(TEXT("total_ms=%.1f"), Prev * 1000.0) + Parts;
+}
+
+void UHexapodBootSubsystem::OnPostLoadMap(UWorld* World)
+{
+	if (World && World->IsGameWorld())
+		MarkStage(EHexapodBootStage::MapLoaded);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 메시 비동기 로드
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBootSubsystem::OnMeshesLoaded()
+{
+	MarkStage(EHexapodBootStage::MeshesLoaded);
+
+	TArray<TFunction<void()>> Callbacks = MoveTemp(MeshCallbacks);
+	for (TFunction<void()>& Callback : Callbacks)
+		Callback();
+}
+
+void UHexapodBootSubsystem::WhenMeshesLoaded(TFunction<void()> Callback)
+{
+	if (!MeshHandle.IsValid() || HasStage(EHexapodBootStage::MeshesLoaded))
+		Callback();
+	else
+		MeshCallbacks.Add(MoveTemp(Callback));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 조기 소켓: 맵 로드 전부터 포트를 점유하고 BOOTING 응답
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodBootSubsystem::OpenEarlyListeners()
+{
+	ISocketSubsystem* SocketSub = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSub) return;
+
+	for (int32 i = 0; i < NumRobots; i++)
+	{
+		TUniquePtr<FEarlyListener> Listener = MakeUnique<FEarlyListener>();
+		Listener->Port   = BasePort + i;
+		Listener->Socket = SocketSub->CreateSocket(NAME_DGram, TEXT("HexapodUDP"), false);
+		if (!Listener->Socket) continue;
+
+		TSharedRef<FInternetAddr> Addr = SocketSub->CreateInternetAddr();
+		Addr->SetAnyAddress();
+		Addr->SetPort(Listener->Port);
+
+		Listener->Socket->SetNonBlocking(true);
+		Listener->Socket->SetReuseAddr(true);
+		if (!Listener->Socket->Bind(*Addr))
+		{
+			UE_LOG(LogTemp, Error, TEXT("HexapodBoot: UDP 포트 %d 열기 실패"), Listener->Port);
+			CloseListener(*Listener, true);
+			continue;
+		}
+
+		Listener->Receiver = new FUdpSocketReceiver(Listener->Socket, FTimespan::FromMilliseconds(100),
+		                                            *FString::Printf(TEXT("HexapodBoot-%d"), Listener->Port));
+		Listener->Receiver->OnDataReceived().BindUObject(this, &UHexapodBootSubsystem::OnEarlyDatagram, Listener.Get());
+		Listener->Receiver->Start();
+		EarlyListeners.Add(MoveTemp(Listener));
+	}
+}
+
+void UHexapodBootSubsystem::CloseListener(FEarlyListener& Listener, bool bDestroySocket)
+{
+	// 수신 스레드를 먼저 멈춘 뒤 소켓 해제 (또는 넘겨줌)
+	if (Listener.Receiver)
+	{
+		delete Listener.Receiver;
+		Listener.Receiver = nullptr;
+	}
+	if (bDestroySocket && Listener.Socket)
+	{
+		Listener.Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Listener.Socket);
+	}
+	Listener.Socket = nullptr;
+}
+
+void UHexapodBootSubsystem::OnEarlyDatagram(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender,
+                                            FEarlyListener* Listener)
+{
+	// 수신 스레드: 명령은 처리하지 않고 기동 중임만 알림. 보낸 쪽은 READY 대상으로 기억
+	{
+		FScopeLock ScopeLock(&Listener->Lock);
+		Listener->Waiting.AddUnique(Sender);
+	}
+
+	const int32 Stage = LastStage;
+	const TCHAR* StageName = Stage >= 0 ? HexapodBootStageNames[Stage] : TEXT("process");
+	const FString Msg = FString::Printf(TEXT("BOOTING %s %.1f\n"), StageName,
+	                                    (FPlatformTime::Seconds() - GStartTime) * 1000.0);
+
+	const FTCHARToUTF8 Converted(*Msg);
+	int32 Sent = 0;
+	Listener->Socket->SendTo(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length(), Sent,
+	                         *Sender.ToInternetAddr());
+}
+
+FSocket* UHexapodBootSubsystem::TakeListenSocket(int32 Port, TArray<FIPv4Endpoint>& OutWaiting)
+{
+	for (int32 i = 0; i < EarlyListeners.Num(); i++)
+	{
+		FEarlyListener& Listener = *EarlyListeners[i];
+		if (Listener.Port != Port) continue;
+
+		FSocket* Socket = Listener.Socket;
+		CloseListener(Listener, false);
+		OutWaiting = MoveTemp(Listener.Waiting);
+		EarlyListeners.RemoveAt(i);
+		return Socket;
+	}
+	return nullptr;
+}
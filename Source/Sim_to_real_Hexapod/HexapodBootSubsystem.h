@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/ArrayReader.h"
+#include "HexapodBootSubsystem.generated.h"
+
+class FSocket;
+class FUdpSocketReceiver;
+struct FStreamableHandle;
+
+/** 기동 단계 — 순서대로 한 번씩 기록 (GStartTime 기준 초) */
+enum class EHexapodBootStage : uint8
+{
+	EngineInit,      // 게임 인스턴스 초기화 (엔진 초기화 끝)
+	MapLoaded,       // 시작 맵 로드 완료
+	MeshesLoaded,    // 로봇 메시 비동기 로드 완료 (빠른 기동만)
+	RobotsSpawned,   // 로봇 스폰 완료 (빠른 기동만)
+	FirstStep,       // 첫 물리 스텝 → READY
+	Count
+};
+
+/**
+ * UHexapodBootSubsystem
+ *
+ * 헤드리스 시뮬레이션 인스턴스의 기동 시간 측정 + 빠른 기동(-HexapodFastBoot) 준비.
+ * 게임 인스턴스 초기화 시점(맵 로드 전)에 만들어지므로 기동 초반 작업을 맵 로드와 겹칠 수 있음.
+ *
+ * ── 빠른 기동 ─────────────────────────────────────────────────────────────
+ *  UnrealEditor-Cmd <프로젝트> /Engine/Maps/Entry?game=HexapodFastBoot -game -nullrhi -nosound
+ *                   -HexapodFastBoot -HexapodRobots=8 -HexapodBasePort=7777 [-HexapodCollisionOnly]
+ *  (-HexapodProfile= 과 함께면 네트워크 로봇 0 대 — 측정 로봇은 UHexapodProfileSubsystem 이 직접 스폰)
+ *
+ *  1) 맵 로드 전에 포트 BasePort … BasePort+Robots-1 을 먼저 열어 둠.
+ *     그동안 들어온 데이터그램에는 "BOOTING <단계> <경과 ms>" 로 바로 응답 (수신 스레드).
+ *  2) 로봇 메시 4종을 비동기 로드 시작 → 맵 로드와 겹침.
+ *  3) AHexapodFastBootGameMode 가 메시 로드를 기다려 로봇 스폰.
+ *     UHexapodNetworkComponent 는 미리 열린 소켓을 넘겨받고(TakeListenSocket),
+ *     기다리던 클라이언트에게 첫 물리 스텝 뒤 "READY ..." 전송.
+ *
+ * ── 기동 시간 ─────────────────────────────────────────────────────────────
+ *  빠른 기동이 아니어도 단계 시각을 기록. 첫 물리 스텝에서 한 번 로그로 출력하고,
+ *  "HELLO" 명령의 READY 응답에도 붙임:
+ *  "READY port=7777 total_ms=.. engine_ms=.. map_ms=.. meshes_ms=.. spawn_ms=.. first_step_ms=.."
+ *  각 값은 직전 단계 이후 추가로 걸린 시간 (기록되지 않은 단계 = 0, 겹친 구간은 뒤 단계에서 제외).
+ */
+UCLASS()
+class SIM_TO_REAL_HEXAPOD_API UHexapodBootSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** 단계 시각 기록 (이미 기록된 단계는 무시). FirstStep 이면 기동 시간 로그 출력 */
+	void MarkStage(EHexapodBootStage Stage);
+	bool HasStage(EHexapodBootStage Stage) const { return StageTimes[static_cast<int32>(Stage)] >= 0.0; }
+
+	/** "total_ms=.. engine_ms=.. ..." */
+	FString GetBreakdown() const;
+
+	bool IsFastBoot() const { return bFastBoot; }
+	int32 GetNumRobots() const { return NumRobots; }
+	int32 GetBasePort() const { return BasePort; }
+	bool IsCollisionOnly() const { return bCollisionOnly; }
+
+	/**
+	 * 미리 열어 둔 Port 소켓의 소유권을 넘김 (수신 스레드 정지 후). 없으면 nullptr.
+	 * OutWaiting: BOOTING 응답을 받은 클라이언트 (READY 를 보낼 대상)
+	 */
+	FSocket* TakeListenSocket(int32 Port, TArray<FIPv4Endpoint>& OutWaiting);
+
+	/** 로봇 메시 비동기 로드가 끝나면 (요청하지 않았거나 이미 끝났으면 즉시) 호출 */
+	void WhenMeshesLoaded(TFunction<void()> Callback);
+
+private:
+	/** 게임 스레드 소유권 이전 전까지 수신 스레드가 응답하는 조기 소켓 */
+	struct FEarlyListener
+	{
+		int32 Port = 0;
+		FSocket* Socket = nullptr;
+		FUdpSocketReceiver* Receiver = nullptr;
+		FCriticalSection Lock;
+		TArray<FIPv4Endpoint> Waiting;
+	};
+
+	double StageTimes[static_cast<int32>(EHexapodBootStage::Count)];
+	TAtomic<int32> LastStage { -1 };
+
+	bool  bFastBoot = false;
+	bool  bCollisionOnly = false;
+	int32 NumRobots = 1;
+	int32 BasePort  = 7777;
+
+	TArray<TUniquePtr<FEarlyListener>> EarlyListeners;
+
+	TSharedPtr<FStreamableHandle> MeshHandle;
+	TArray<TFunction<void()>> MeshCallbacks;
+
+	FDelegateHandle PostLoadMapHandle;
+
+	void OpenEarlyListeners();
+	void CloseListener(FEarlyListener& Listener, bool bDestroySocket);
+	void OnEarlyDatagram(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender, FEarlyListener* Listener);
+	void OnPostLoadMap(UWorld* World);
+	void OnMeshesLoaded();
+};
@@ -0,0 +1,459 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodDatasetSubsystem.h"
+#include "HexapodRobot.h"
+#include "HexapodBatchSubsystem.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+void FHexapodDatasetShard::Allocate(int32 Capacity)
+{
+	Obs.SetNumUninitialized(Capacity * HexapodDatasetObsDim);
+	Action.SetNumUninitialized(Capacity * 18);
+	Reward.SetNumUninitialized(Capacity);
+	Done.SetNumUninitialized(Capacity);
+	Episode.SetNumUninitialized(Capacity);
+	Robot.SetNumUninitialized(Capacity);
+	Rows = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// npy 1.0 형식: 매직 + 버전 + 헤더 길이 + 파이썬 dict 헤더 (64 바이트 정렬) + 원시 데이터
+// ─────────────────────────────────────────────────────────────────────────────
+
+static int64 WriteNpy(const FString& Path, const TCHAR* Descr, int32 Rows, int32 Cols, const void* Data, int64 Bytes)
+{
+	const FString Shape = Cols > 0 ? FString::Printf(TEXT("(%d, %d)"), Rows, Cols) : FString::Printf(TEXT("(%d,)"), Rows);
+	FString Dict = FString::Printf(TEXT("{'descr': '%s', 'fortran_order': False, 'shape': %s, }"), Descr, *Shape);
+
+	// 10 바이트 고정부 + dict + '\n' 을 64 의 배수로 → 데이터 시작이 정렬되어 mmap 시 그대로 사용
+	const int32 Unpadded = 10 + Dict.Len() + 1;
+	Dict += FString::ChrN((64 - Unpadded % 64) % 64, TEXT(' '));
+	Dict += TEXT("\n");
+
+	TArray<uint8> Header = { 0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0 };
+	const uint16 DictLen = static_cast<uint16>(Dict.Len());
+	Header.Add(DictLen & 0xFF);
+	Header.Add(DictLen >> 8);
+	for (int32 i = 0; i < Dict.Len(); i++)
+		Header.Add(static_cast<uint8>(Dict[i]));
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Ar) return -1;
+	Ar->Serialize(Header.GetData(), Header.Num());
+	Ar->Serialize(const_cast<void*>(Data), Bytes);
+	Ar->Close();
+	return Header.Num() + Bytes;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// FHexapodDatasetWriter — 채워진 샤드를 npy 로 쓰고 버퍼를 되돌려 주는 스레드
+// ─────────────────────────────────────────────────────────────────────────────
+
+class FHexapodDatasetWriter : public FRunnable
+{
+public:
+	FHexapodDatasetWriter(const FString& InDir, int32 InShardRows, TQueue<FHexapodDatasetShard*, EQueueMode::Spsc>& InFree)
+		: Dir(InDir), ShardRows(InShardRows), FreeShards(InFree)
+	{
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	}
+
+	virtual ~FHexapodDatasetWriter() override
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+
+	/** 게임 스레드 → 쓰기 대기열 */
+	void Submit(FHexapodDatasetShard* Shard)
+	{
+		Pending.Enqueue(Shard);
+		WakeEvent->Trigger();
+	}
+
+	virtual uint32 Run() override
+	{
+		while (!bStopping)
+		{
+			WakeEvent->Wait(FTimespan::FromMilliseconds(100));
+			Drain();
+		}
+		// Stop 직전에 넘어온 마지막 샤드까지 저장
+		Drain();
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping = true;
+		WakeEvent->Trigger();
+	}
+
+	TAtomic<int32> ShardsWritten { 0 };
+	TAtomic<int64> BytesWritten  { 0 };
+	TAtomic<int32> WriteErrors   { 0 };
+
+private:
+	struct FIndexEntry
+	{
+		FString Name;
+		int32 Rows = 0;
+		int32 FirstEpisode = 0;
+		int32 LastEpisode = 0;
+	};
+
+	FString Dir;
+	int32   ShardRows;
+	TQueue<FHexapodDatasetShard*, EQueueMode::Spsc> Pending;   // 게임 스레드 → 쓰기 스레드
+	TQueue<FHexapodDatasetShard*, EQueueMode::Spsc>& FreeShards;
+	FEvent* WakeEvent = nullptr;
+	TAtomic<bool> bStopping { false };
+
+	TArray<FIndexEntry> Entries;
+	int64 IndexRows = 0;
+
+	void Drain()
+	{
+		FHexapodDatasetShard* Shard = nullptr;
+		while (Pending.Dequeue(Shard))
+		{
+			WriteShard(*Shard);
+			Shard->Rows = 0;
+			FreeShards.Enqueue(Shard);
+		}
+	}
+
+	void WriteShard(const FHexapodDatasetShard& S);
+	void WriteIndex(int64 DroppedRows) const;
+};
+
+void FHexapodDatasetWriter::WriteShard(const FHexapodDatasetShard& S)
+{
+	if (S.Rows == 0) return;
+
+	const FString Name = FString::Printf(TEXT("shard_%05d"), S.Index);
+	const FString ShardDir = Dir / Name;
+	IFileManager::Get().MakeDirectory(*ShardDir, true);
+
+	const int32 R = S.Rows;
+	const int64 Results[] = {
+		WriteNpy(ShardDir / TEXT("obs.npy"),     TEXT("<f4"), R, HexapodDatasetObsDim, S.Obs.GetData(),     sizeof(float) * R * HexapodDatasetObsDim),
+		WriteNpy(ShardDir / TEXT("action.npy"),  TEXT("<f4"), R, 18,                   S.Action.GetData(),  sizeof(float) * R * 18),
+		WriteNpy(ShardDir / TEXT("reward.npy"),  TEXT("<f4"), R, 0,                    S.Reward.GetData(),  sizeof(float) * R),
+		WriteNpy(ShardDir / TEXT("done.npy"),    TEXT("|u1"), R, 0,                    S.Done.GetData(),    sizeof(uint8) * R),
+		WriteNpy(ShardDir / TEXT("episode.npy"), TEXT("<i4"), R, 0,                    S.Episode.GetData(), sizeof(int32) * R),
+		WriteNpy(ShardDir / TEXT("robot.npy"),   TEXT("<i4"), R, 0,                    S.Robot.GetData(),   sizeof(int32) * R),
+	};
+	for (int64 Bytes : Results)
+	{
+		if (Bytes < 0) WriteErrors++;
+		else           BytesWritten += Bytes;
+	}
+
+	FIndexEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Name = Name;
+	Entry.Rows = R;
+	Entry.FirstEpisode = S.Episode[0];
+	Entry.LastEpisode  = S.Episode[0];
+	for (int32 i = 1; i < R; i++)
+	{
+		Entry.FirstEpisode = FMath::Min(Entry.FirstEpisode, S.Episode[i]);
+		Entry.LastEpisode  = FMath::Max(Entry.LastEpisode,  S.Episode[i]);
+	}
+	IndexRows += R;
+	ShardsWritten++;
+
+	// 샤드마다 색인을 통째로 다시 씀 → 기록 도중에도 항상 읽을 수 있는 상태
+	WriteIndex(S.DroppedRows);
+}
+
+void FHexapodDatasetWriter::WriteIndex(int64 DroppedRows) const
+{
+	FString Json = TEXT("{\n");
+	Json += TEXT("  \"format\": \"hexapod-offline-rl\",\n  \"version\": 2,\n");
+	Json += TEXT("  \"next_obs\": \"same robot, next row, if not done and same episode\",\n");
+	Json += FString::Printf(TEXT("  \"shard_rows\": %d,\n  \"total_rows\": %lld,\n  \"dropped_rows\": %lld,\n"),
+	                        ShardRows, IndexRows, DroppedRows);
+	Json += TEXT("  \"columns\": {\n");
+	Json += FString::Printf(TEXT("    \"obs\": {\"dtype\": \"<f4\", \"shape\": [%d]},\n"), HexapodDatasetObsDim);
+	Json += TEXT("    \"action\": {\"dtype\": \"<f4\", \"shape\": [18]},\n");
+	Json += TEXT("    \"reward\": {\"dtype\": \"<f4\", \"shape\": []},\n");
+	Json += TEXT("    \"done\": {\"dtype\": \"|u1\", \"shape\": []},\n");
+	Json += TEXT("    \"episode\": {\"dtype\": \"<i4\", \"shape\": []},\n");
+	Json += TEXT("    \"robot\": {\"dtype\": \"<i4\", \"shape\": []}\n");
+	Json += TEXT("  },\n  \"shards\": [\n");
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		const FIndexEntry& E = Entries[i];
+		Json += FString::Printf(TEXT("    {\"dir\": \"%s\", \"rows\": %d, \"episodes\": [%d, %d]}%s\n"),
+		                        *E.Name, E.Rows, E.FirstEpisode, E.LastEpisode, i + 1 < Entries.Num() ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("  ]\n}\n");
+
+	// 임시 파일 → 교체: 로더가 반쯤 쓰인 색인을 읽지 않도록
+	const FString Temp = Dir / TEXT("index.json.tmp");
+	if (FFileHelper::SaveStringToFile(Json, *Temp))
+		IFileManager::Get().Move(*(Dir / TEXT("index.json")), *Temp, true, true);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 생명주기
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodDatasetSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UHexapodDatasetSubsystem::Deinitialize()
+{
+	StopRecording();
+	Super::Deinitialize();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 시작 / 종료
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodDatasetSubsystem::StartRecording(const FString& Dir, int32 InShardRows)
+{
+	UWorld* World = GetWorld();
+	UHexapodBatchSubsystem* Batch = World ? World->GetSubsystem<UHexapodBatchSubsystem>() : nullptr;
+	if (IsRecording() || !Batch) return false;
+
+	OutputDir = Dir.IsEmpty()
+		? FPaths::ProjectSavedDir() / TEXT("HexapodDataset") / FDateTime::Now().ToString()
+		: Dir;
+	if (!IFileManager::Get().MakeDirectory(*OutputDir, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HexapodDataset: 디렉터리를 만들 수 없습니다: %s"), *OutputDir);
+		return false;
+	}
+
+	// 버퍼는 여기서 한 번만 할당 — 기록 중 게임 스레드 할당 없음
+	ShardRows = FMath::Max(InShardRows, 256);
+	ShardPool.Reset();
+	FreeShards.Empty();
+	for (int32 i = 0; i < FMath::Max(MaxBufferedShards, 2); i++)
+	{
+		TUniquePtr<FHexapodDatasetShard>& Shard = ShardPool.Add_GetRef(MakeUnique<FHexapodDatasetShard>());
+		Shard->Allocate(ShardRows);
+		FreeShards.Enqueue(Shard.Get());
+	}
+	Current = nullptr;
+	Tracks.Reset();
+	NextShard = NextEpisode = NextRobotId = 0;
+	TotalRows = DroppedRows = 0;
+
+	Writer = new FHexapodDatasetWriter(OutputDir, ShardRows, FreeShards);
+	WriterThread = FRunnableThread::Create(Writer, TEXT("HexapodDatasetWriter"), 0, TPri_BelowNormal);
+
+	PostBatchHandle = Batch->OnPostBatch().AddUObject(this, &UHexapodDatasetSubsystem::CollectStep);
+
+	UE_LOG(LogTemp, Log, TEXT("HexapodDataset: 기록 시작 → %s (샤드 %d 행, 버퍼 %d 개)"),
+	       *OutputDir, ShardRows, ShardPool.Num());
+	return true;
+}
+
+void UHexapodDatasetSubsystem::StopRecording()
+{
+	if (!IsRecording()) return;
+
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->OnPostBatch().Remove(PostBatchHandle);
+	PostBatchHandle.Reset();
+	for (FRobotTrack& Track : Tracks)
+		FlushPending(Track);
+	SubmitCurrent();
+
+	// Stop() → 남은 샤드 저장 → 스레드 종료 대기
+	WriterThread->Kill(true);
+	delete WriterThread;
+	WriterThread = nullptr;
+
+	UE_LOG(LogTemp, Log, TEXT("HexapodDataset: 기록 종료 — %lld 행, 샤드 %d 개, %.1f MB, 버린 행 %lld, 쓰기 오류 %d (%s)"),
+	       TotalRows, static_cast<int32>(Writer->ShardsWritten), Writer->BytesWritten / (1024.0 * 1024.0),
+	       DroppedRows, static_cast<int32>(Writer->WriteErrors), *OutputDir);
+
+	delete Writer;
+	Writer = nullptr;
+	FreeShards.Empty();
+	ShardPool.Reset();
+	Current = nullptr;
+}
+
+void UHexapodDatasetSubsystem::SubmitCurrent()
+{
+	if (!Current) return;
+	Current->Index       = NextShard++;
+	Current->DroppedRows = DroppedRows;
+	Writer->Submit(Current);
+	Current = nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 수집 (게임 스레드, 배치 PostPhysics 직후)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodDatasetSubsystem::MarkEpisodeEnd(const AHexapodRobot* Robot)
+{
+	if (!IsRecording() || !Robot) return;
+	for (FRobotTrack& Track : Tracks)
+		if (Track.Robot == Robot) Track.bDonePending = true;
+}
+
+UHexapodDatasetSubsystem::FRobotTrack& UHexapodDatasetSubsystem::GetTrack(int32 BatchIndex, AHexapodRobot* Robot)
+{
+	if (Tracks.Num() <= BatchIndex)
+		Tracks.SetNum(BatchIndex + 1);
+
+	// 새 로봇이거나 스왑 제거로 다른 로봇이 이 자리에 온 경우 → 새 에피소드
+	// 떠난 로봇 / 옮겨 온 로봇의 옛 자리에 붙잡아 둔 행은 여기서 씀 (다음 행과 이어지지 않음)
+	FRobotTrack& Track = Tracks[BatchIndex];
+	if (Track.Robot != Robot)
+	{
+		int32 RobotId = INDEX_NONE;
+		for (FRobotTrack& Other : Tracks)
+		{
+			if (Other.Robot != Robot) continue;
+			RobotId = Other.RobotId;
+			FlushPending(Other);
+			Other.Robot = nullptr;
+		}
+		FlushPending(Track);
+
+		Track = FRobotTrack();
+		Track.Robot   = Robot;
+		Track.RobotId = RobotId != INDEX_NONE ? RobotId : NextRobotId++;
+		Track.Episode = NextEpisode++;
+	}
+	return Track;
+}
+
+void UHexapodDatasetSubsystem::FlushPending(FRobotTrack& Track)
+{
+	if (!Track.bHasPending) return;
+	Track.bHasPending = false;
+
+	if (!Current && !FreeShards.Dequeue(Current))
+	{
+		// 쓰기 스레드가 밀림 → 시뮬레이션은 멈추지 않고 이 행만 버림.
+		// 앞 행이 버린 행 너머와 이어지지 않도록 에피소드를 끊음 (이미 done 이면 끊겨 있음)
+		Current = nullptr;
+		DroppedRows++;
+		if (!Track.bPendingDone && Track.PendingEpisode == Track.Episode)
+			Track.Episode = NextEpisode++;
+		return;
+	}
+
+	const int32 Row = Current->Rows++;
+	FMemory::Memcpy(&Current->Obs[Row * HexapodDatasetObsDim], Track.PendingObs, sizeof(Track.PendingObs));
+	FMemory::Memcpy(&Current->Action[Row * 18], Track.PendingAction, sizeof(Track.PendingAction));
+	Current->Reward[Row]  = Track.PendingReward;
+	Current->Done[Row]    = Track.bPendingDone ? 1 : 0;
+	Current->Episode[Row] = Track.PendingEpisode;
+	Current->Robot[Row]   = Track.RobotId;
+	TotalRows++;
+
+	if (Current->Rows == ShardRows)
+		SubmitCurrent();
+}
+
+void UHexapodDatasetSubsystem::CollectStep(float DeltaTime)
+{
+	UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>();
+	if (!Batch || !IsRecording()) return;
+
+	const double Start = FPlatformTime::Seconds();
+	const float MinUpZ = FMath::Cos(FMath::DegreesToRadians(FallTiltDeg));
+
+	for (int32 i = 0; i < Batch->GetNumRobots(); i++)
+	{
+		AHexapodRobot* Robot = Batch->GetRobot(i);
+		FRobotTrack& Track = GetTrack(i, Robot);
+
+		// 이번 스텝 결과 관측 (배치 캐시)
+		float Obs[HexapodDatasetObsDim];
+		Robot->GetObservation(Obs);
+		Robot->GetFootObservation(Obs + HexapodObsFields);
+
+		// 넘어짐은 넘어지는 순간 한 번만 done
+		const bool bFell = Robot->GetActorUpVector().Z < MinUpZ;
+		const bool bFellNow = bFell && !Track.bFallen;
+		Track.bFallen = bFell;
+
+		if (Track.bDonePending)
+		{
+			// 이번 스텝 직전에 RESET / LOAD 로 순간이동 → 붙잡아 둔 직전 행이 에피소드의 진짜 끝.
+			// 이번 행 (이전 에피소드 관측 → 복원된 상태의 결과) 은 두 에피소드에 걸치므로 버림
+			Track.bPendingDone = true;
+			FlushPending(Track);
+			Track.Episode = NextEpisode++;
+			Track.bDonePending = false;
+		}
+		else if (Track.bHasPrev)
+		{
+			FlushPending(Track);
+
+			FMemory::Memcpy(Track.PendingObs, Track.PrevObs, sizeof(Track.PrevObs));
+			FMemory::Memcpy(Track.PendingAction, Robot->GetConstraintTargets(), sizeof(Track.PendingAction));
+			Track.PendingReward  = Batch->GetReward(i);
+			Track.PendingEpisode = Track.Episode;
+			Track.bPendingDone   = bFellNow;
+			Track.bHasPending    = true;
+
+			if (bFellNow)
+				Track.Episode = NextEpisode++;
+		}
+		FMemory::Memcpy(Track.PrevObs, Obs, sizeof(Obs));
+		Track.bHasPrev = true;
+	}
+
+	// 배치에서 빠진 자리 (스왑 제거로 로봇 수가 줄어듦)
+	for (int32 i = Batch->GetNumRobots(); i < Tracks.Num(); i++)
+		FlushPending(Tracks[i]);
+	Tracks.SetNum(FMath::Min(Tracks.Num(), Batch->GetNumRobots()));
+
+	CollectMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 콘솔 명령: Hexapod.Dataset start [디렉터리] [샤드 행 수] | stop | stats
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodDatasetSubsystem::LogStats() const
+{
+	if (!IsRecording())
+	{
+		UE_LOG(LogTemp, Log, TEXT("HexapodDataset: 기록 중 아님"));
+		return;
+	}
+	UE_LOG(LogTemp, Log, TEXT("HexapodDataset: %lld 행 (샤드 %d 개 저장, %.1f MB), 버린 행 %lld, 에피소드 %d, 수집 %.3f ms/스텝 → %s"),
+	       TotalRows, static_cast<int32>(Writer->ShardsWritten), Writer->BytesWritten / (1024.0 * 1024.0),
+	       DroppedRows, NextEpisode, CollectMs, *OutputDir);
+}
+
+static void DatasetCommand(const TArray<FString>& Args, UWorld* World)
+{
+	UHexapodDatasetSubsystem* Dataset = World ? World->GetSubsystem<UHexapodDatasetSubsystem>() : nullptr;
+	if (!Dataset) return;
+
+	const FString Mode = Args.Num() > 0 ? Args[0].ToLower() : TEXT("stats");
+	if (Mode == TEXT("start"))
+		Dataset->StartRecording(Args.Num() > 1 ? Args[1] : FString(), Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 16384);
+	else if (Mode == TEXT("stop"))
+		Dataset->StopRecording();
+	else
+		Dataset->LogStats();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GDatasetCommand(
+	TEXT("Hexapod.Dataset"),
+	TEXT("오프라인 RL 전이 기록. 인자: start [디렉터리] [샤드 행 수] | stop | stats"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&DatasetCommand));
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "HexapodKinematics.h"
+#include "HexapodSensorComponent.h"
+#include "HexapodDatasetSubsystem.generated.h"
+
+class AHexapodRobot;
+class UHexapodDatasetSubsystem;
+class FHexapodDatasetWriter;
+class FRunnableThread;
+
+/** 데이터셋 관측 차원: OBS 24 필드 + 발끝 FK 21 필드 */
+constexpr int32 HexapodDatasetObsDim = HexapodObsFields + HexapodKinematics::FootFields;
+
+/**
+ * 샤드 하나 분량의 열(column) 버퍼. 시작 시 MaxBufferedShards 개만 할당해 돌려 씀.
+ * 게임 스레드가 채우고 → 쓰기 스레드가 npy 로 저장한 뒤 → 빈 버퍼로 되돌려 줌.
+ */
+struct FHexapodDatasetShard
+{
+	int32 Index = 0;          // 샤드 번호 (파일 이름)
+	int32 Rows  = 0;
+	int64 DroppedRows = 0;    // 이 샤드를 넘길 때까지 버퍼 부족으로 버린 누적 행 수
+
+	TArray<float> Obs;        // Rows × HexapodDatasetObsDim
+	TArray<float> Action;     // Rows × 18
+	TArray<float> Reward;
+	TArray<uint8> Done;
+	TArray<int32> Episode;
+	TArray<int32> Robot;
+
+	void Allocate(int32 Capacity);
+};
+
+/**
+ * UHexapodDatasetSubsystem
+ *
+ * 오프라인 RL 용 전이(transition)를 엔진에서 바로 열 단위 샤드로 저장.
+ * Python 이 OBS 텍스트를 파싱해 모을 필요 없이, 로더가 np.load(mmap_mode='r') 로 바로 매핑.
+ *
+ * ── 행 하나 (로봇 1대 × 물리 스텝 1회, 배치 PostPhysics 직후) ──────────────
+ *  obs     <f4 (45)  : 행동을 고른 시점의 관측 (이전 스텝 결과: OBS 24 + FEET 21)
+ *  action  <f4 (18)  : 이번 스텝에 적용된 관절 드라이브 목표
+ *  reward  <f4       : 이번 스텝 결과 보상 (UHexapodBatchSubsystem)
+ *  done    |u1       : 에피소드의 마지막 전이 (RESET / 스냅샷 복원 직전 스텝, 넘어진 스텝)
+ *  episode <i4       : 에피소드 번호 (월드 전체에서 유일)
+ *  robot   <i4       : 로봇 번호 (기록 시작 후 처음 본 순서)
+ *  다음 관측 = 같은 robot 의 다음 행 obs. 단 done 이 아니고 episode 가 같을 때만
+ *
+ *  로봇마다 가장 최근 행은 한 스텝 늦게 씀: RESET / LOAD 는 PrePhysics 에 순간이동하므로
+ *  그 스텝 행은 두 에피소드에 걸침 → 버리고, 붙잡아 둔 직전 행을 done 으로 기록.
+ *  행이 빠지는 경우 (버퍼 부족으로 버림 / 배치 스왑 제거로 인덱스 이동) 는 done 없이 episode 번호를 바꿈
+ *  → 끊긴 앞 행은 잘린(truncated) 에피소드의 끝, 다음 관측으로 이어 붙이지 않음.
+ *
+ * ── 파일 ──────────────────────────────────────────────────────────────────
+ *  <Dir>/shard_00000/obs.npy, action.npy, ...   : 샤드마다 ShardRows 행 (마지막 샤드만 짧을 수 있음)
+ *  <Dir>/index.json                             : 열 dtype/shape, 샤드 목록과 행 수 (샤드 완료마다 갱신)
+ *
+ * ── 스레드 ────────────────────────────────────────────────────────────────
+ *  수집은 UHexapodBatchSubsystem::OnPostBatch (기록 중에만 등록).
+ *  게임 스레드는 미리 할당된 버퍼에 복사만 하고, 파일 쓰기는 전용 스레드(FHexapodDatasetWriter).
+ *  버퍼 MaxBufferedShards 개가 모두 디스크 대기 중이면 시뮬레이션을 멈추지 않고 행을 버린 뒤 개수를 기록.
+ *
+ * 콘솔: Hexapod.Dataset start [디렉터리] [샤드 행 수] | stop | stats
+ */
+UCLASS()
+class SIM_TO_REAL_HEXAPOD_API UHexapodDatasetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	/** 빈 Dir 이면 Saved/HexapodDataset/<시각> */
+	bool StartRecording(const FString& Dir, int32 InShardRows);
+	void StopRecording();
+	bool IsRecording() const { return Writer != nullptr; }
+
+	/** 이 로봇의 직전 행을 에피소드 끝으로 표시하고, 순간이동을 가로지르는 다음 행은 버림 (RESET / LOAD 등) */
+	void MarkEpisodeEnd(const AHexapodRobot* Robot);
+
+	void CollectStep(float DeltaTime);
+	void LogStats() const;
+
+	/** 몸통 기울기가 이 각도(도)를 넘으면 넘어짐 → done */
+	float FallTiltDeg = 60.f;
+
+	/** 쓰기 대기까지 포함한 샤드 버퍼 수 (메모리 상한 = MaxBufferedShards × ShardRows × 약 270 B) */
+	int32 MaxBufferedShards = 4;
+
+private:
+	/** 배치 인덱스별 기록 상태 (배치 스왑 제거로 인덱스가 바뀌면 Robot 비교로 감지) */
+	struct FRobotTrack
+	{
+		const AHexapodRobot* Robot = nullptr;
+		int32 RobotId = INDEX_NONE;
+		int32 Episode = 0;
+		bool  bHasPrev = false;
+		bool  bDonePending = false;
+		bool  bFallen = false;
+		float PrevObs[HexapodDatasetObsDim];
+
+		// 아직 쓰지 않은 가장 최근 행 (다음 스텝에 RESET / LOAD 면 done 으로 바뀜)
+		bool  bHasPending = false;
+		bool  bPendingDone = false;
+		int32 PendingEpisode = 0;
+		float PendingReward = 0.f;
+		float PendingObs[HexapodDatasetObsDim];
+		float PendingAction[18];
+	};
+
+	FDelegateHandle PostBatchHandle;
+
+	FHexapodDatasetWriter* Writer = nullptr;
+	FRunnableThread*       WriterThread = nullptr;
+
+	TArray<TUniquePtr<FHexapodDatasetShard>> ShardPool;   // 소유권 (전체 버퍼)
+	TQueue<FHexapodDatasetShard*, EQueueMode::Spsc> FreeShards;   // 쓰기 스레드 → 게임 스레드
+	FHexapodDatasetShard* Current = nullptr;
+
+	TArray<FRobotTrack> Tracks;
+	FString OutputDir;
+	int32 ShardRows   = 16384;
+	int32 NextShard   = 0;
+	int32 NextEpisode = 0;
+	int32 NextRobotId = 0;
+	int64 TotalRows   = 0;
+	int64 DroppedRows = 0;
+	double CollectMs  = 0.0;
+
+	FRobotTrack& GetTrack(int32 BatchIndex, AHexapodRobot* Robot);
+	void FlushPending(FRobotTrack& Track);
+	void SubmitCurrent();
+};
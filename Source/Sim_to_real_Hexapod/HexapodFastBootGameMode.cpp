@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodFastBootGameMode.h"
+#include "HexapodBootSubsystem.h"
+#include "HexapodRobot.h"
+#include "HexapodNetworkComponent.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+AHexapodFastBootGameMode::AHexapodFastBootGameMode()
+{
+	DefaultPawnClass = nullptr;
+}
+
+void AHexapodFastBootGameMode::StartPlay()
+{
+	Super::StartPlay();
+	SpawnGround();
+
+	UHexapodBootSubsystem* Boot = GetGameInstance() ? GetGameInstance()->GetSubsystem<UHexapodBootSubsystem>() : nullptr;
+	if (!Boot)
+	{
+		SpawnRobots();
+		return;
+	}
+
+	// 메시 로드가 맵 로드보다 늦으면 여기서 기다림 (이미 끝났으면 바로 스폰)
+	TWeakObjectPtr<AHexapodFastBootGameMode> WeakThis(this);
+	Boot->WhenMeshesLoaded([WeakThis]()
+	{
+		if (AHexapodFastBootGameMode* This = WeakThis.Get())
+			This->SpawnRobots();
+	});
+}
+
+void AHexapodFastBootGameMode::SpawnGround()
+{
+	// 메시/머티리얼 없이 충돌만 있는 바닥 (윗면 Z = 0)
+	AActor* Ground = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+	if (!Ground) return;
+
+	UBoxComponent* Box = NewObject<UBoxComponent>(Ground, TEXT("Ground"));
+	Box->SetMobility(EComponentMobility::Static);
+	Box->SetBoxExtent(FVector(GroundHalfExtent, GroundHalfExtent, 50.f));
+	Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Box->SetRelativeLocation(FVector(0.f, 0.f, -50.f));
+	Ground->SetRootComponent(Box);
+	Box->RegisterComponent();
+}
+
+void AHexapodFastBootGameMode::SpawnRobots()
+{
+	UWorld* World = GetWorld();
+	UHexapodBootSubsystem* Boot = GetGameInstance() ? GetGameInstance()->GetSubsystem<UHexapodBootSubsystem>() : nullptr;
+
+	const int32 Count    = Boot ? Boot->GetNumRobots() : 1;
+	const int32 BasePort = Boot ? Boot->GetBasePort() : 7777;
+	const bool  bCollisionOnly = Boot && Boot->IsCollisionOnly();
+
+	Robots.Reset(Count);
+	for (int32 i = 0; i < Count; i++)
+	{
+		// 전방(로컬 -Y)과 수직인 X 축으로 나란히
+		const FTransform Transform(FRotator::ZeroRotator, FVector(Spacing * i, 0.f, SpawnHeight));
+		AHexapodRobot* Robot = World->SpawnActorDeferred<AHexapodRobot>(AHexapodRobot::StaticClass(), Transform, nullptr, nullptr,
+		                                                                ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Robot) continue;
+
+		Robot->bCollisionOnly = bCollisionOnly;
+		if (UHexapodNetworkComponent* Network = Robot->FindComponentByClass<UHexapodNetworkComponent>())
+			Network->ListenPort = BasePort + i;
+		Robot->FinishSpawning(Transform);
+		Robots.Add(Robot);
+	}
+
+	if (Boot)
+		Boot->MarkStage(EHexapodBootStage::RobotsSpawned);
+	UE_LOG(LogTemp, Log, TEXT("HexapodFastBoot: 로봇 %d 대 스폰 (포트 %d~%d)"), Robots.Num(), BasePort, BasePort + Count - 1);
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "HexapodFastBootGameMode.generated.h"
+
+class AHexapodRobot;
+
+/**
+ * AHexapodFastBootGameMode
+ *
+ * 헤드리스 학습/벤치마크용 최소 월드. 빈 엔진 맵(/Engine/Maps/Entry)에서 실행:
+ *  조명/하늘/포스트 프로세스 없음, 바닥은 메시 없는 박스 충돌체 하나.
+ *  로봇은 UHexapodBootSubsystem 의 메시 비동기 로드가 끝나면 스폰 (-HexapodRobots, -HexapodBasePort).
+ *
+ *  UnrealEditor-Cmd <프로젝트> /Engine/Maps/Entry?game=HexapodFastBoot -game -nullrhi -nosound -HexapodFastBoot
+ *  (게임 모드 별칭은 DefaultEngine.ini 의 GameModeClassAliases)
+ */
+UCLASS()
+class SIM_TO_REAL_HEXAPOD_API AHexapodFastBootGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+	AHexapodFastBootGameMode();
+
+	virtual void StartPlay() override;
+	/** 플레이어 폰 없음 — 로봇은 UDP 로만 조작 */
+	virtual void RestartPlayer(AController* NewPlayer) override {}
+
+	/** 로봇 간 옆 간격 (cm) */
+	UPROPERTY(EditAnywhere, Category = "FastBoot")
+	float Spacing = 200.f;
+
+	/** 스폰 높이 (cm, 바닥 윗면 = 0) */
+	UPROPERTY(EditAnywhere, Category = "FastBoot")
+	float SpawnHeight = 50.f;
+
+	/** 바닥 충돌 박스 반 크기 (cm) */
+	UPROPERTY(EditAnywhere, Category = "FastBoot")
+	float GroundHalfExtent = 50000.f;
+
+private:
+	UPROPERTY(Transient)
+	TArray<AHexapodRobot*> Robots;
+
+	void SpawnGround();
+	void SpawnRobots();
+};
@@ -0,0 +1,368 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodGaitSweepSubsystem.h"
+#include "HexapodRobot.h"
+#include "HexapodSnapshotComponent.h"
+#include "HexapodBatchSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// 모든 설정의 공통 출발 상태를 저장하는 스냅샷 슬롯
+static constexpr int32 SweepStartSlot = 0;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 생명주기
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodGaitSweepSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 설정 목록
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodGaitSweepSubsystem::BuildGrid(const FHexapodSweepSettings& InSettings, TArray<FHexapodGaitParams>& OutConfigs)
+{
+	const FHexapodGaitParams& Lo = InSettings.Min;
+	const FHexapodGaitParams& Hi = InSettings.Max;
+	const float LoArr[4] = { Lo.WalkSpeed, Lo.MaxStride, Lo.TurnRate, Lo.LiftAngle };
+	const float HiArr[4] = { Hi.WalkSpeed, Hi.MaxStride, Hi.TurnRate, Hi.LiftAngle };
+
+	// 범위가 한 점인 축은 값 1개 → 의미 없는 중복 설정을 만들지 않음
+	int32 Steps[4];
+	int32 Total = 1;
+	for (int32 a = 0; a < 4; a++)
+	{
+		Steps[a] = FMath::IsNearlyEqual(LoArr[a], HiArr[a]) ? 1 : FMath::Max(InSettings.GridSteps, 2);
+		Total *= Steps[a];
+	}
+
+	OutConfigs.Reset(Total);
+	for (int32 n = 0; n < Total; n++)
+	{
+		float Values[4];
+		int32 Rem = n;
+		for (int32 a = 0; a < 4; a++)
+		{
+			const int32 k = Rem % Steps[a];
+			Rem /= Steps[a];
+			Values[a] = Steps[a] == 1 ? LoArr[a] : FMath::Lerp(LoArr[a], HiArr[a], (float)k / (Steps[a] - 1));
+		}
+		OutConfigs.Add({ Values[0], Values[1], Values[2], Values[3] });
+	}
+}
+
+void UHexapodGaitSweepSubsystem::BuildRandom(const FHexapodSweepSettings& InSettings, TArray<FHexapodGaitParams>& OutConfigs)
+{
+	const FHexapodGaitParams& Lo = InSettings.Min;
+	const FHexapodGaitParams& Hi = InSettings.Max;
+	FRandomStream Stream(InSettings.Seed);
+
+	OutConfigs.Reset(InSettings.NumConfigs);
+	for (int32 n = 0; n < InSettings.NumConfigs; n++)
+	{
+		FHexapodGaitParams P;
+		P.WalkSpeed = FMath::Lerp(Lo.WalkSpeed, Hi.WalkSpeed, Stream.GetFraction());
+		P.MaxStride = FMath::Lerp(Lo.MaxStride, Hi.MaxStride, Stream.GetFraction());
+		P.TurnRate  = FMath::Lerp(Lo.TurnRate,  Hi.TurnRate,  Stream.GetFraction());
+		P.LiftAngle = FMath::Lerp(Lo.LiftAngle, Hi.LiftAngle, Stream.GetFraction());
+		OutConfigs.Add(P);
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 시작 / 종료
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodGaitSweepSubsystem::StartSweep(const FHexapodSweepSettings& InSettings)
+{
+	UHexapodBatchSubsystem* Batch = GetWorld() ? GetWorld()->GetSubsystem<UHexapodBatchSubsystem>() : nullptr;
+	if (IsRunning() || !Batch)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HexapodGaitSweep: 이미 실행 중입니다 (Hexapod.GaitSweep cancel)."));
+		return false;
+	}
+
+	Settings = InSettings;
+	if (Settings.bRandom)
+		BuildRandom(Settings, Configs);
+	else
+		BuildGrid(Settings, Configs);
+	if (Configs.Num() == 0) return false;
+
+	Results.Reset(Configs.Num());
+	Results.SetNum(Configs.Num());
+	NextConfig      = 0;
+	Finished        = 0;
+	SettleRemaining = Settings.SettleTime;
+	bSettled        = false;
+	StartWallTime   = FPlatformTime::Seconds();
+
+	SpawnRobots();
+	if (SweepRobots.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HexapodGaitSweep: 로봇 스폰 실패"));
+		return false;
+	}
+
+	// 측정은 배치 계산(관절 각도/보상)이 끝난 물리 스텝 직후
+	PostBatchHandle = Batch->OnPostBatch().AddUObject(this, &UHexapodGaitSweepSubsystem::SweepUpdate);
+	bRunning = true;
+
+	UE_LOG(LogTemp, Log, TEXT("HexapodGaitSweep: %s 설정 %d 개, 로봇 %d 대, 설정당 %.1f 초"),
+	       Settings.bRandom ? TEXT("랜덤") : TEXT("격자"), Configs.Num(), SweepRobots.Num(), Settings.Duration);
+	return true;
+}
+
+void UHexapodGaitSweepSubsystem::SpawnRobots()
+{
+	UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>();
+
+	// 맵에 배치된 로봇 옆에서 시작
+	FVector Origin(0.f, 0.f, 50.f);
+	if (Batch->GetNumRobots() > 0)
+		Origin = Batch->GetRobot(0)->GetActorLocation() + FVector(Settings.Spacing * 2.f, 0.f, 0.f);
+
+	const int32 Count = FMath::Clamp(Settings.NumRobots, 1, Configs.Num());
+	SweepRobots.Reset(Count);
+	for (int32 k = 0; k < Count; k++)
+	{
+		// 전방(로컬 -Y)과 수직인 X 축으로 간격을 두어 서로 부딪히지 않게
+		const FTransform Transform(FRotator::ZeroRotator, Origin + FVector(Settings.Spacing * k, 0.f, 0.f));
+		if (AHexapodRobot* Robot = Batch->SpawnHeadlessRobot(nullptr, Transform))
+			SweepRobots.Add(Robot);
+	}
+	Lanes.Reset();
+	Lanes.SetNum(SweepRobots.Num());
+}
+
+void UHexapodGaitSweepSubsystem::CancelSweep()
+{
+	if (!IsRunning()) return;
+	UE_LOG(LogTemp, Log, TEXT("HexapodGaitSweep: 취소 (%d / %d 완료)"), Finished, Configs.Num());
+	Cleanup();
+}
+
+void UHexapodGaitSweepSubsystem::Cleanup()
+{
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->OnPostBatch().Remove(PostBatchHandle);
+	PostBatchHandle.Reset();
+	bRunning = false;
+	for (AHexapodRobot* Robot : SweepRobots)
+		if (IsValid(Robot)) Robot->Destroy();
+	SweepRobots.Reset();
+	Lanes.Reset();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 평가: 복원 → 보행 → 측정 (로봇마다 독립, 끝난 로봇은 바로 다음 설정)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodGaitSweepSubsystem::SweepUpdate(float DeltaTime)
+{
+	// 스폰 직후: 모든 로봇이 바닥에 자리 잡은 뒤 공통 출발 상태 저장
+	if (!bSettled)
+	{
+		SettleRemaining -= DeltaTime;
+		if (SettleRemaining > 0.f) return;
+		bSettled = true;
+
+		for (AHexapodRobot* Robot : SweepRobots)
+			if (UHexapodSnapshotComponent* Snapshot = Robot->FindComponentByClass<UHexapodSnapshotComponent>())
+				Snapshot->SaveSlot(SweepStartSlot);
+		for (int32 k = 0; k < Lanes.Num(); k++)
+			BeginRun(k);
+		return;
+	}
+
+	for (int32 k = 0; k < Lanes.Num(); k++)
+		if (Lanes[k].Config != INDEX_NONE)
+			SampleRun(k, DeltaTime);
+
+	if (Finished == Configs.Num())
+		FinishSweep();
+}
+
+void UHexapodGaitSweepSubsystem::BeginRun(int32 LaneIndex)
+{
+	FLane& Lane = Lanes[LaneIndex];
+	AHexapodRobot* Robot = SweepRobots[LaneIndex];
+	UHexapodMovementComponent* Movement = Robot->FindComponentByClass<UHexapodMovementComponent>();
+
+	Lane = FLane();
+	if (NextConfig >= Configs.Num() || !Movement) return;
+
+	// 물리 스텝 직후 복원 → 다음 스텝은 복원된 상태에서 새 설정으로 시작
+	if (UHexapodSnapshotComponent* Snapshot = Robot->FindComponentByClass<UHexapodSnapshotComponent>())
+		Snapshot->RestoreSlot(SweepStartSlot);
+
+	Lane.Config = NextConfig++;
+	Movement->SetGaitParams(Configs[Lane.Config]);
+	Movement->SetGaitPhase(0.f);
+	Movement->SetMoveForward(Settings.Input.X);
+	Movement->SetMoveRight(Settings.Input.Y);
+
+	const FRotator Rotation = Robot->GetActorRotation();
+	Lane.StartLocation = Robot->GetActorLocation();
+	Lane.StartForward  = -Robot->GetActorRightVector();   // 몸통 전방 = 로컬 -Y
+	Lane.StartYaw      = Rotation.Yaw;
+	Lane.LastLocation  = Lane.StartLocation;
+	Lane.LastYaw       = Rotation.Yaw;
+}
+
+void UHexapodGaitSweepSubsystem::SampleRun(int32 LaneIndex, float DeltaTime)
+{
+	FLane& Lane = Lanes[LaneIndex];
+	const AHexapodRobot* Robot = SweepRobots[LaneIndex];
+	const FRotator Rotation = Robot->GetActorRotation();
+	const FVector  Location = Robot->GetActorLocation();
+
+	Lane.Elapsed += DeltaTime;
+	Lane.YawTravel += FMath::FindDeltaAngleDegrees(Lane.LastYaw, Rotation.Yaw);
+	Lane.Path      += FVector::Dist2D(Lane.LastLocation, Location);
+	Lane.LastYaw      = Rotation.Yaw;
+	Lane.LastLocation = Location;
+	Lane.Samples++;
+	const double dR = Rotation.Roll - Lane.RollMean;
+	Lane.RollMean += dR / Lane.Samples;
+	Lane.RollM2   += dR * (Rotation.Roll - Lane.RollMean);
+	const double dP = Rotation.Pitch - Lane.PitchMean;
+	Lane.PitchMean += dP / Lane.Samples;
+	Lane.PitchM2   += dP * (Rotation.Pitch - Lane.PitchMean);
+
+	const bool bFell = Robot->GetActorUpVector().Z < FMath::Cos(FMath::DegreesToRadians(Settings.FallTiltDeg));
+	if (bFell || Lane.Elapsed >= Settings.Duration)
+		EndRun(LaneIndex, bFell);
+}
+
+void UHexapodGaitSweepSubsystem::EndRun(int32 LaneIndex, bool bFell)
+{
+	FLane& Lane = Lanes[LaneIndex];
+	const AHexapodRobot* Robot = SweepRobots[LaneIndex];
+
+	FHexapodSweepResult& R = Results[Lane.Config];
+	R.Config       = Lane.Config;
+	R.Params       = Configs[Lane.Config];
+	R.Distance     = FVector::DotProduct(Robot->GetActorLocation() - Lane.StartLocation, Lane.StartForward) * 0.01f;
+	R.PathLength   = (float)Lane.Path * 0.01f;
+	R.HeadingDrift = FMath::Abs(FMath::FindDeltaAngleDegrees(Lane.StartYaw, Robot->GetActorRotation().Yaw));
+	R.YawRate      = Lane.Elapsed > 0.f ? (float)Lane.YawTravel / Lane.Elapsed : 0.f;
+	R.TiltVariance = Lane.Samples > 1 ? (float)((Lane.RollM2 + Lane.PitchM2) / (Lane.Samples - 1)) : 0.f;
+	R.Falls        = bFell ? 1 : 0;
+	R.SimTime      = Lane.Elapsed;
+
+	if (FMath::IsNearlyZero(Settings.Input.Y))
+	{
+		R.Score = R.Distance - Settings.HeadingWeight * FMath::DegreesToRadians(R.HeadingDrift);
+	}
+	else
+	{
+		// 회전: 목표 속도를 얼마나 잘 따르는지 + 그동안 움직인 거리
+		const float TargetRate = FMath::Sign(Settings.Input.Y) * Settings.TargetYawRate;
+		R.Score = R.PathLength - Settings.TurnWeight * FMath::DegreesToRadians(FMath::Abs(R.YawRate - TargetRate));
+	}
+	R.Score -= Settings.TiltWeight * R.TiltVariance * FMath::Square(PI / 180.f)
+	         + Settings.FallPenalty * R.Falls;
+	Finished++;
+
+	BeginRun(LaneIndex);
+	if (Lanes[LaneIndex].Config == INDEX_NONE)
+	{
+		// 남은 설정 없음 → 이 로봇은 멈춰 둠
+		if (UHexapodMovementComponent* Movement = SweepRobots[LaneIndex]->FindComponentByClass<UHexapodMovementComponent>())
+		{
+			Movement->SetMoveForward(0.f);
+			Movement->SetMoveRight(0.f);
+		}
+	}
+}
+
+void UHexapodGaitSweepSubsystem::FinishSweep()
+{
+	Results.Sort([](const FHexapodSweepResult& A, const FHexapodSweepResult& B) { return A.Score > B.Score; });
+
+	UE_LOG(LogTemp, Log, TEXT("HexapodGaitSweep: 설정 %d 개 완료 (%.1f 초)"),
+	       Results.Num(), FPlatformTime::Seconds() - StartWallTime);
+	const int32 Shown = FMath::Min(Results.Num(), 10);
+	for (int32 r = 0; r < Shown; r++)
+	{
+		const FHexapodSweepResult& R = Results[r];
+		UE_LOG(LogTemp, Log, TEXT("  #%d [%d] WalkSpeed %.2f MaxStride %.1f TurnRate %.1f LiftAngle %.1f → 거리 %.2f m (경로 %.2f m), 방향 %.1f°, 회전 %.1f°/s, 기울기 분산 %.2f, 넘어짐 %d, 점수 %.3f"),
+		       r + 1, R.Config, R.Params.WalkSpeed, R.Params.MaxStride, R.Params.TurnRate, R.Params.LiftAngle,
+		       R.Distance, R.PathLength, R.HeadingDrift, R.YawRate, R.TiltVariance, R.Falls, R.Score);
+	}
+
+	WriteResults();
+	Cleanup();
+}
+
+void UHexapodGaitSweepSubsystem::WriteResults() const
+{
+	FString Csv = TEXT("rank,config,walk_speed,max_stride,turn_rate,lift_angle,distance_m,path_m,heading_drift_deg,yaw_rate_dps,tilt_var_deg2,falls,sim_time_s,score\n");
+	for (int32 r = 0; r < Results.Num(); r++)
+	{
+		const FHexapodSweepResult& R = Results[r];
+		Csv += FString::Printf(TEXT("%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f,%.4f,%d,%.3f,%.4f\n"),
+		                       r + 1, R.Config, R.Params.WalkSpeed, R.Params.MaxStride, R.Params.TurnRate, R.Params.LiftAngle,
+		                       R.Distance, R.PathLength, R.HeadingDrift, R.YawRate, R.TiltVariance, R.Falls, R.SimTime, R.Score);
+	}
+
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("HexapodSweep") /
+	                     FString::Printf(TEXT("GaitSweep_%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(Csv, *Path))
+		UE_LOG(LogTemp, Log, TEXT("HexapodGaitSweep: 결과 저장 %s"), *Path);
+	else
+		UE_LOG(LogTemp, Error, TEXT("HexapodGaitSweep: 결과 저장 실패 %s"), *Path);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 콘솔 명령: Hexapod.GaitSweep grid|random|cancel ...
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void GaitSweep(const TArray<FString>& Args, UWorld* World)
+{
+	UHexapodGaitSweepSubsystem* Sweep = World ? World->GetSubsystem<UHexapodGaitSweepSubsystem>() : nullptr;
+	if (!Sweep) return;
+
+	const FString Mode = Args.Num() > 0 ? Args[0].ToLower() : TEXT("grid");
+	if (Mode == TEXT("cancel"))
+	{
+		Sweep->CancelSweep();
+		return;
+	}
+
+	FHexapodSweepSettings Settings;
+	Settings.bRandom = Mode == TEXT("random");
+	if (Args.Num() > 1)
+	{
+		const int32 Count = FMath::Max(1, FCString::Atoi(*Args[1]));
+		if (Settings.bRandom) Settings.NumConfigs = Count;
+		else                  Settings.GridSteps  = Count;
+	}
+	if (Args.Num() > 2) Settings.NumRobots = FMath::Max(1, FCString::Atoi(*Args[2]));
+	if (Args.Num() > 3) Settings.Duration  = FMath::Max(0.1f, FCString::Atof(*Args[3]));
+	if (Args.Num() > 4)
+	{
+		// 회전 입력이 있을 때만 TurnRate 도 스윕
+		Settings.Input.Y = FMath::Clamp(FCString::Atof(*Args[4]), -1.f, 1.f);
+		if (!FMath::IsNearlyZero(Settings.Input.Y))
+		{
+			Settings.Min.TurnRate = 0.f;
+			Settings.Max.TurnRate = 40.f;
+		}
+	}
+	if (Args.Num() > 5) Settings.Seed = FCString::Atoi(*Args[5]);
+	if (Args.Num() > 6) Settings.TargetYawRate = FMath::Abs(FCString::Atof(*Args[6]));
+
+	Sweep->StartSweep(Settings);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GGaitSweepCommand(
+	TEXT("Hexapod.GaitSweep"),
+	TEXT("보행 파라미터 스윕. 인자: grid <축당 값 수> | random <설정 수> [로봇 수] [초] [회전 입력] [시드] [목표 회전 속도 도/초], 또는 cancel"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GaitSweep));
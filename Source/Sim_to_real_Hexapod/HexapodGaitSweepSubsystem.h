@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HexapodMovementComponent.h"
+#include "HexapodGaitSweepSubsystem.generated.h"
+
+class AHexapodRobot;
+
+/** 스윕 설정 (콘솔 명령 Hexapod.GaitSweep 에서 채움) */
+struct FHexapodSweepSettings
+{
+	bool  bRandom    = false;
+	int32 GridSteps  = 4;        // 격자: 축마다 값 개수 (범위가 한 점인 축은 1개)
+	int32 NumConfigs = 256;      // 랜덤: 설정 수
+	int32 Seed       = 1;
+
+	int32 NumRobots  = 32;       // 동시에 평가하는 로봇 수
+	float Duration   = 10.f;     // 설정 하나당 시뮬레이션 시간 (초)
+	float SettleTime = 1.f;      // 스폰 후 서있는 자세로 안정화 (초, 1회)
+	float Spacing    = 200.f;    // 로봇 간 옆 간격 (cm)
+
+	/** 보행 입력 (X 전진, Y 회전). TurnRate 는 Y != 0 일 때만 결과에 영향 */
+	FVector2D Input = FVector2D(1.f, 0.f);
+
+	/** 회전 스윕(Input.Y != 0)의 목표 회전 속도 (도/초, 크기). Y > 0 → 왼쪽 보폭이 커져 +Yaw(오른쪽) 회전 */
+	float TargetYawRate = 30.f;
+
+	FHexapodGaitParams Min = { 0.5f, 10.f, 20.f, 20.f };
+	FHexapodGaitParams Max = { 2.0f, 35.f, 20.f, 60.f };
+
+	/** 넘어짐 판정: 몸통 기울기 (도) */
+	float FallTiltDeg = 60.f;
+
+	// 순위 점수 (직진)   = 전진 거리 (m) - HeadingWeight × 방향 오차 (rad) - TiltWeight × 기울기 분산 (rad²) - FallPenalty × 넘어짐
+	// 순위 점수 (회전)   = 이동 경로 길이 (m) - TurnWeight × |회전 속도 - 목표| (rad/s) - (기울기, 넘어짐 동일)
+	//  회전 중에는 시작 방향 기준 거리와 방향 변화가 목표 자체와 반대로 움직이므로 쓰지 않음
+	float HeadingWeight = 0.5f;
+	float TurnWeight    = 2.f;
+	float TiltWeight    = 10.f;
+	float FallPenalty   = 100.f;
+};
+
+/** 설정 하나의 평가 결과 */
+struct FHexapodSweepResult
+{
+	int32 Config = INDEX_NONE;
+	FHexapodGaitParams Params;
+
+	float Distance     = 0.f;    // 시작 방향 기준 전진 거리 (m)
+	float PathLength   = 0.f;    // 지나온 수평 경로 길이 (m)
+	float HeadingDrift = 0.f;    // 시작 Yaw 대비 변화 (도, 절대값)
+	float YawRate      = 0.f;    // 평균 회전 속도 (도/초, 부호 있음, 누적 Yaw / 시간)
+	float TiltVariance = 0.f;    // Var(roll) + Var(pitch) (도²)
+	int32 Falls        = 0;
+	float SimTime      = 0.f;    // 실제 평가한 시간 (넘어지면 그 시점까지)
+	float Score        = 0.f;
+};
+
+/**
+ * UHexapodGaitSweepSubsystem
+ *
+ * 보행 파라미터(WalkSpeed / MaxStride / TurnRate / LiftAngle) 격자·랜덤 스윕.
+ * 로봇 NumRobots 대를 옆으로 나란히 스폰(UHexapodBatchSubsystem::SpawnHeadlessRobot)해 설정을 하나씩 나눠 맡기고, 모두 같은 월드에서 동시에 걸림.
+ * 보행/관절 계산은 UHexapodBatchSubsystem 이 일괄 처리하므로 로봇 수가 늘어도 틱 수는 그대로.
+ *
+ *  측정은 UHexapodBatchSubsystem::OnPostBatch (배치 계산이 끝난 물리 스텝 직후, 스윕 실행 중에만 등록)
+ *  스폰 → SettleTime 동안 서있는 자세 → 스냅샷 슬롯 0 저장 (모든 설정의 공통 출발 상태)
+ *  설정마다: 슬롯 0 복원 → 보행 파라미터 + 입력 → Duration 동안 측정 → 결과 기록 → 다음 설정
+ *  끝나면 점수순 CSV: Saved/HexapodSweep/GaitSweep_<시각>.csv
+ *
+ * 시뮬레이션 시간 기준이므로 고정 프레임으로 실행하면 실시간보다 빠르게 끝남:
+ *  UnrealEditor-Cmd <프로젝트> -game -nullrhi -benchmark -fps=100 (물리 서브스텝 설정과 맞출 것)
+ *
+ * 콘솔: Hexapod.GaitSweep grid <축당 값 수> [로봇 수] [초] [회전 입력] [시드] [목표 회전 속도]
+ *       Hexapod.GaitSweep random <설정 수> [로봇 수] [초] [회전 입력] [시드] [목표 회전 속도]
+ *       Hexapod.GaitSweep cancel
+ */
+UCLASS()
+class SIM_TO_REAL_HEXAPOD_API UHexapodGaitSweepSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** 설정 목록을 만들고 로봇을 스폰. 이미 실행 중이면 false */
+	bool StartSweep(const FHexapodSweepSettings& InSettings);
+	void CancelSweep();
+	bool IsRunning() const { return bRunning; }
+
+	void SweepUpdate(float DeltaTime);
+
+	/** 격자 / 랜덤 설정 목록 (스윕 없이도 사용 가능) */
+	static void BuildGrid(const FHexapodSweepSettings& InSettings, TArray<FHexapodGaitParams>& OutConfigs);
+	static void BuildRandom(const FHexapodSweepSettings& InSettings, TArray<FHexapodGaitParams>& OutConfigs);
+
+private:
+	/** 로봇 한 대가 맡은 평가 상태 */
+	struct FLane
+	{
+		int32   Config = INDEX_NONE;   // 평가 중인 설정 (INDEX_NONE = 쉬는 중)
+		float   Elapsed = 0.f;
+		FVector StartLocation = FVector::ZeroVector;
+		FVector StartForward  = FVector::ZeroVector;
+		float   StartYaw = 0.f;
+
+		// 회전 측정: 직전 샘플 대비 누적 (±180° 경계를 넘어도 이어짐)
+		FVector LastLocation = FVector::ZeroVector;
+		float   LastYaw   = 0.f;
+		double  YawTravel = 0.0;   // 도
+		double  Path      = 0.0;   // cm
+
+		// 기울기 분산 (Welford)
+		int32  Samples = 0;
+		double RollMean = 0.0, RollM2 = 0.0;
+		double PitchMean = 0.0, PitchM2 = 0.0;
+	};
+
+	UPROPERTY(Transient)
+	TArray<AHexapodRobot*> SweepRobots;
+
+	FHexapodSweepSettings Settings;
+	FDelegateHandle PostBatchHandle;
+
+	TArray<FHexapodGaitParams>  Configs;
+	TArray<FHexapodSweepResult> Results;
+	TArray<FLane> Lanes;
+	bool   bRunning   = false;
+	int32  NextConfig = 0;
+	int32  Finished   = 0;
+	float  SettleRemaining = 0.f;
+	bool   bSettled = false;
+	double StartWallTime = 0.0;
+
+	void SpawnRobots();
+	void BeginRun(int32 LaneIndex);
+	void SampleRun(int32 LaneIndex, float DeltaTime);
+	void EndRun(int32 LaneIndex, bool bFell);
+	void FinishSweep();
+	void WriteResults() const;
+	void Cleanup();
+};
@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+// UE 의존성 없는 순수 C++ 헤더 — 엔진 모듈과 외부 클라이언트가 같은 코드를 공유
+#include <cstdint>
+#include <cmath>
+
+/**
+ * HexapodKinematics
+ *
+ * 관절 각도 18개 → 몸통 좌표계 발끝 위치 6개 + 지지 다각형.
+ * 실제 로봇도 서보 각도만 알기 때문에 시뮬레이션과 같은 식을 그대로 쓸 수 있음.
+ *
+ * ── 다리 모델 (몸통 좌표계, cm) ──────────────────────────────────────────
+ *  Hip   : Mount[leg] (Hip 관절 피벗)에서 몸통 Z 축 회전
+ *  Thigh : Hip 끝(Coxa, CoxaSide, CoxaDrop)에서 다리 평면 안 상하 회전 (+ = 들어올림)
+ *  Calf  : Thigh 끝(Femur)에서 무릎을 아래로 굽힘 (+ = 더 굽힘)
+ *
+ *  d = (cos ψ, sin ψ, 0), n = (-sin ψ, cos ψ, 0), ψ = Hip - Zero[0]
+ *  φ1 = Thigh - Zero[1],  φ2 = φ1 - (Calf - Zero[2])
+ *  Foot = Mount + d (Coxa + Femur cos φ1 + Tibia cos φ2) + n CoxaSide + z (CoxaDrop + Femur sin φ1 + Tibia sin φ2)
+ *
+ * ── 입력 각도 (도, AHexapodRobot::GetFootJointAngles) ────────────────────
+ *  Hip   : 몸통 기준 Hip 상대 회전의 Yaw = OBS 값 그대로 (장착 방향 HipRotations.Yaw 포함)
+ *  Thigh : Hip 기준 Thigh 상대 회전의 Pitch. 정지 자세 = ThighRotation.Pitch (10°).
+ *          Thigh 관절은 피치 관절이라 OBS 의 Thigh(상대 Yaw)는 관절과 무관하게 ≈0 → FK 에 못 씀
+ *  Calf  : Thigh 기준 Calf 상대 회전의 Yaw = OBS 값 그대로. 정지 자세 = CalfRotator.Yaw (90°),
+ *          무릎을 굽힐수록 커짐 (RESET 서있는 자세 ≈ 150°)
+ *
+ * ── 기본 치수 출처 (AHexapodRobot 생성 기본값, 정지 자세 Leg1 에서 계산) ────
+ *  Mount    = HipOffsets + HipRotations · HipConstraintOffset(-3, 0, 0)
+ *  Coxa     = 5     : Hip 피벗 → Thigh 피벗 = -HipConstraintOffset.X 3 + ThighOffset.X 2
+ *  CoxaSide = 0     : ThighOffset.Y -2.5 + ThighConstraintOffset.Z 2.5 (ThighRotation Roll 90° 로 옆 방향)
+ *  CoxaDrop = -1.5  : ThighOffset.Z
+ *  Femur    = 5.59  : Thigh 피벗 → 무릎 피벗 (CalfOffset + CalfRotator · CalfConstraintOffset)
+ *                     = 다리 평면 (5.24, 1.94) → 길이 5.59, 수평 위 20.30°
+ *  Tibia    = 8.15  : 무릎 피벗 → 발끝 패드 (0.96, 0, 1.905) = 다리 평면 (8.14, 0.46) → 길이 8.15, 수평 위 3.24°
+ *                     발끝 패드: Tibia-996.fbx 정점 z 최소 19.05 mm 인 패드 중심 (임포트 배율 0.1 → cm)
+ *  Zero[0]  = 0     : ψ = 관측 Hip Yaw 그대로
+ *  Zero[1]  = 10 - 20.30 = -10.30     : 정지 Pitch 10° 에서 φ1 = 20.30°
+ *  Zero[2]  = 90 - (20.30 - 3.24) = 72.93 : 정지 Calf 90° 에서 φ2 = 3.24°
+ *  Hip/Thigh ±40°, 무릎 굽힘 0~90° 에서 강체 사슬로 돌려 본 발끝과 이 식의 차이 0.01 cm 이하 (반올림 오차).
+ *
+ * ── 관측 추가 필드 (FootFields = 21) ─────────────────────────────────────
+ *  [0..17]  발끝 x y z × 6 (Leg 순서)
+ *  [18]     접지 비트마스크 (bit leg)
+ *  [19]     안정 여유 (cm): 몸통 원점 → 지지 다각형 경계 최소 거리, 밖이면 음수
+ *  [20]     지지 다각형 넓이 (cm²)
+ */
+namespace HexapodKinematics
+{
+	constexpr int32_t NumLegs    = 6;
+	constexpr int32_t FootFields = NumLegs * 3 + 3;
+
+	struct FLegGeometry
+	{
+		float MountX[NumLegs];
+		float MountY[NumLegs];
+		float MountZ[NumLegs];
+
+		float Coxa     = 5.f;
+		float CoxaSide = 0.f;
+		float CoxaDrop = -1.5f;
+		float Femur    = 5.59f;
+		float Tibia    = 8.15f;
+
+		float ZeroDeg[3] = { 0.f, -10.30f, 72.93f };   // 입력 각도 기준 [Hip, Thigh, Calf] (위 출처 참고)
+
+		/** 발끝이 가장 낮은 발에서 이 높이(cm) 안이면 접지로 판정 */
+		float ContactTolerance = 1.f;
+
+		static FLegGeometry Default()
+		{
+			FLegGeometry G;
+			// HipOffsets 에서 장착 방향으로 HipConstraintOffset(-3 cm) 만큼 안쪽
+			const float X[NumLegs] = { 5.879f, 8.f, 5.879f, -5.879f, -8.f, -5.879f };
+			const float Y[NumLegs] = { 7.879f, 0.f, -7.879f, 7.879f, 0.f, -7.879f };
+			for (int32_t i = 0; i < NumLegs; i++)
+			{
+				G.MountX[i] = X[i];
+				G.MountY[i] = Y[i];
+				G.MountZ[i] = 0.f;
+			}
+			return G;
+		}
+	};
+
+	/**
+	 * 로봇 1대 FK. 다리 축으로 연속 배열을 도는 루프라 컴파일러가 SIMD 로 묶을 수 있음.
+	 * @param Angles   입력 각도 18개 (도, Leg * 3 + Joint, 위 "입력 각도" 정의)
+	 * @param OutFeet  발끝 x y z × 6
+	 */
+	inline void ComputeFeet(const FLegGeometry& G, const float* Angles, float* OutFeet)
+	{
+		constexpr float DegToRad = 3.14159265358979f / 180.f;
+
+		float Psi[NumLegs], Phi1[NumLegs], Phi2[NumLegs];
+		for (int32_t i = 0; i < NumLegs; i++)
+		{
+			Psi[i]  = (Angles[i * 3 + 0] - G.ZeroDeg[0]) * DegToRad;
+			Phi1[i] = (Angles[i * 3 + 1] - G.ZeroDeg[1]) * DegToRad;
+			Phi2[i] = Phi1[i] - (Angles[i * 3 + 2] - G.ZeroDeg[2]) * DegToRad;
+		}
+
+		float Reach[NumLegs], Height[NumLegs], CosPsi[NumLegs], SinPsi[NumLegs];
+		for (int32_t i = 0; i < NumLegs; i++)
+		{
+			Reach[i]  = G.Coxa + G.Femur * std::cos(Phi1[i]) + G.Tibia * std::cos(Phi2[i]);
+			Height[i] = G.CoxaDrop + G.Femur * std::sin(Phi1[i]) + G.Tibia * std::sin(Phi2[i]);
+			CosPsi[i] = std::cos(Psi[i]);
+			SinPsi[i] = std::sin(Psi[i]);
+		}
+
+		for (int32_t i = 0; i < NumLegs; i++)
+		{
+			OutFeet[i * 3 + 0] = G.MountX[i] + CosPsi[i] * Reach[i] - SinPsi[i] * G.CoxaSide;
+			OutFeet[i * 3 + 1] = G.MountY[i] + SinPsi[i] * Reach[i] + CosPsi[i] * G.CoxaSide;
+			OutFeet[i * 3 + 2] = G.MountZ[i] + Height[i];
+		}
+	}
+
+	/** 원점에서 선분 AB 까지 거리 */
+	inline float DistanceToSegment(float Ax, float Ay, float Bx, float By)
+	{
+		const float Dx = Bx - Ax, Dy = By - Ay;
+		const float Len2 = Dx * Dx + Dy * Dy;
+		float T = Len2 > 0.f ? -(Ax * Dx + Ay * Dy) / Len2 : 0.f;
+		T = T < 0.f ? 0.f : (T > 1.f ? 1.f : T);
+		const float Px = Ax + T * Dx, Py = Ay + T * Dy;
+		return std::sqrt(Px * Px + Py * Py);
+	}
+
+	/**
+	 * 접지 판정 + 지지 다각형 (몸통 XY 평면 투영).
+	 * @param Feet     ComputeFeet 결과
+	 * @param Down     몸통 좌표계 중력 방향 (단위 벡터). 접지 = 이 방향으로 가장 먼 발 근처
+	 * @param OutSupport [마스크, 안정 여유(cm), 넓이(cm²)]
+	 */
+	inline void ComputeSupport(const FLegGeometry& G, const float* Feet, const float Down[3], float* OutSupport)
+	{
+		float Depth[NumLegs];
+		float MaxDepth = -1e30f;
+		for (int32_t i = 0; i < NumLegs; i++)
+		{
+			Depth[i] = Feet[i * 3 + 0] * Down[0] + Feet[i * 3 + 1] * Down[1] + Feet[i * 3 + 2] * Down[2];
+			MaxDepth = Depth[i] > MaxDepth ? Depth[i] : MaxDepth;
+		}
+
+		// 접지 발 (x 오름차순 정렬 — 볼록 껍질 입력)
+		float Px[NumLegs], Py[NumLegs];
+		int32_t Count = 0;
+		uint32_t Mask = 0;
+		for (int32_t i = 0; i < NumLegs; i++)
+		{
+			if (Depth[i] < MaxDepth - G.ContactTolerance) continue;
+			Mask |= 1u << i;
+
+			int32_t k = Count++;
+			while (k > 0 && (Px[k - 1] > Feet[i * 3] || (Px[k - 1] == Feet[i * 3] && Py[k - 1] > Feet[i * 3 + 1])))
+			{
+				Px[k] = Px[k - 1];
+				Py[k] = Py[k - 1];
+				k--;
+			}
+			Px[k] = Feet[i * 3 + 0];
+			Py[k] = Feet[i * 3 + 1];
+		}
+
+		// Andrew monotone chain → 반시계 방향 볼록 껍질
+		float Hx[NumLegs * 2], Hy[NumLegs * 2];
+		int32_t H = 0;
+		auto Cross = [&](int32_t a, int32_t b, float Cx, float Cy)
+		{
+			return (Hx[b] - Hx[a]) * (Cy - Hy[a]) - (Hy[b] - Hy[a]) * (Cx - Hx[a]);
+		};
+		for (int32_t i = 0; i < Count; i++)
+		{
+			while (H >= 2 && Cross(H - 2, H - 1, Px[i], Py[i]) <= 0.f) H--;
+			Hx[H] = Px[i]; Hy[H] = Py[i]; H++;
+		}
+		for (int32_t i = Count - 2, Lower = H + 1; i >= 0; i--)
+		{
+			while (H >= Lower && Cross(H - 2, H - 1, Px[i], Py[i]) <= 0.f) H--;
+			Hx[H] = Px[i]; Hy[H] = Py[i]; H++;
+		}
+		if (H > 1) H--;   // 마지막 점 = 첫 점
+
+		float Area = 0.f;
+		float Margin = 1e30f;
+		bool bInside = H >= 3;
+		for (int32_t i = 0; i < H; i++)
+		{
+			const int32_t j = (i + 1) % H;
+			Area += Hx[i] * Hy[j] - Hx[j] * Hy[i];
+			const float D = DistanceToSegment(Hx[i], Hy[i], Hx[j], Hy[j]);
+			Margin = D < Margin ? D : Margin;
+			// 반시계 껍질: 원점이 모든 변의 왼쪽이면 내부
+			if ((Hx[j] - Hx[i]) * (-Hy[i]) - (Hy[j] - Hy[i]) * (-Hx[i]) < 0.f) bInside = false;
+		}
+		if (H == 0) Margin = 0.f;
+
+		OutSupport[0] = static_cast<float>(Mask);
+		OutSupport[1] = bInside ? Margin : -Margin;
+		OutSupport[2] = 0.5f * std::fabs(Area);
+	}
+
+	/** FK + 지지 다각형 → 관측 추가 필드 21개 */
+	inline void ComputeFootObservation(const FLegGeometry& G, const float* Angles, const float Down[3], float* OutFields)
+	{
+		ComputeFeet(G, Angles, OutFields);
+		ComputeSupport(G, OutFields, Down, OutFields + NumLegs * 3);
+	}
+}
@@ -3,16 +3,16 @@
 
 #include "HexapodMovementComponent.h"
 #include "HexapodRobot.h" 
+#include "HexapodBatchSubsystem.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
 
 // Sets default values for this component's properties
 UHexapodMovementComponent::UHexapodMovementComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
+	//  ó   . Է    ߸ ٽ 
 	PrimaryComponentTick.bCanEverTick = true;
-
-	// ...
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
 }
 
 
@@ -33,56 +33,102 @@ void UHexapodMovementComponent::TickComponent(float DeltaTime, ELevelTick TickTy
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	//UE_LOG(LogTemp, Display, TEXT("InputDirection X: %f\tY: %f"), InputDirection.X, InputDirection.Y);
-	if (InputDirection.SizeSquared() > 0.01f)  // Է 
+	if (IsWalking())  // Է 
 	{
 		GaitPhase = FMath::Fmod(GaitPhase + DeltaTime * WalkSpeed, 1.0f);
 		CalculateStepAndMove(GaitPhase);
 	}
-	else  // Է 
+	else  // Է  ִ ڼ   ݿ  
 	{
 		ResetToCenter();
+		SetComponentTickEnabled(false);
 	}
 	// ...
 }
 
+void UHexapodMovementComponent::SetBatched(bool bInBatched)
+{
+	// ġ ý    Ʈ ü ƽ 
+	bBatched = bInBatched;
+	SetComponentTickEnabled(!bBatched && IsWalking());
+}
+
+void UHexapodMovementComponent::OnInputChanged()
+{
+	const bool bWalking = IsWalking();
+	if (bWalking == bWasWalking) return;
+	bWasWalking = bWalking;
+
+	if (!bBatched)
+	{
+		//  ÿ    ƽ  ResetToCenter   
+		SetComponentTickEnabled(true);
+		return;
+	}
+	if (!HexapodRobot) return;
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->SetRobotWalking(HexapodRobot->GetBatchIndex(), bWalking);
+}
+
+FHexapodGaitParams UHexapodMovementComponent::GetGaitParams() const
+{
+	FHexapodGaitParams Params;
+	Params.WalkSpeed = WalkSpeed;
+	Params.MaxStride = MaxStride;
+	Params.TurnRate  = TurnRate;
+	Params.LiftAngle = LiftAngle;
+	return Params;
+}
+
+void UHexapodMovementComponent::SetGaitParams(const FHexapodGaitParams& Params)
+{
+	WalkSpeed = Params.WalkSpeed;
+	MaxStride = Params.MaxStride;
+	TurnRate  = Params.TurnRate;
+	LiftAngle = Params.LiftAngle;
+}
+
 void UHexapodMovementComponent::CalculateStepAndMove(float GlobalPhase) {
+	float Targets[18];
+	ComputeGaitTargets(GetGaitParams(), InputDirection, GlobalPhase, Targets);
+	if (HexapodRobot) HexapodRobot->SetConstraintTargets(Targets);
+}
+
+//     - ġ ý Ŀ 忡 κ  븦 ÿ 
+void UHexapodMovementComponent::ComputeGaitTargets(const FHexapodGaitParams& Params, const FVector2D& Input, float GlobalPhase, float* OutTargets) {
 	// : Է¿  /  
-	float leftStride = (InputDirection.X * MaxStride) + (InputDirection.Y * TurnRate);
-	float rightStride = (InputDirection.X * MaxStride) - (InputDirection.Y * TurnRate);
+	float leftStride = (Input.X * Params.MaxStride) + (Input.Y * Params.TurnRate);
+	float rightStride = (Input.X * Params.MaxStride) - (Input.Y * Params.TurnRate);
 
 	// ִ  
-	leftStride = FMath::Clamp(leftStride, -MaxStride, MaxStride);
-	rightStride = FMath::Clamp(rightStride, -MaxStride, MaxStride);
+	leftStride = FMath::Clamp(leftStride, -Params.MaxStride, Params.MaxStride);
+	rightStride = FMath::Clamp(rightStride, -Params.MaxStride, Params.MaxStride);
 
 	// Tripod Gait:  ׷ Phase 
 	float phaseA = GlobalPhase;
 	float phaseB = FMath::Fmod(GlobalPhase + 0.5f, 1.0f);
 
 	// Group A: Leg5(L), Leg1(R), Leg3(L)
-	ApplyLegMovement(5, phaseA, true, leftStride);   //  
-	ApplyLegMovement(1, phaseA, false, rightStride);  //  
-	ApplyLegMovement(3, phaseA, true, leftStride);   //  
+	ComputeLegTargets(Params, phaseA, true, leftStride, OutTargets + 5 * 3);   //  
+	ComputeLegTargets(Params, phaseA, false, rightStride, OutTargets + 1 * 3);  //  
+	ComputeLegTargets(Params, phaseA, true, leftStride, OutTargets + 3 * 3);   //  
 
 	// Group B: Leg2(R), Leg4(L), Leg0(R)
-	ApplyLegMovement(2, phaseB, false, rightStride);  //  
-	ApplyLegMovement(4, phaseB, true, leftStride);   //  
-	ApplyLegMovement(0, phaseB, false, rightStride);  //  
+	ComputeLegTargets(Params, phaseB, false, rightStride, OutTargets + 2 * 3);  //  
+	ComputeLegTargets(Params, phaseB, true, leftStride, OutTargets + 4 * 3);   //  
+	ComputeLegTargets(Params, phaseB, false, rightStride, OutTargets + 0 * 3);  //  
 }
 
 /**
-	* ٸ 1 Swing/Stance  Ͽ   
-	* @param LegIndex  ٸ ε (0~5)
+	* ٸ 1 Swing/Stance  Ͽ  ǥ 3 
 	* @param Phase       Ŭ ġ (0.0 ~ 1.0)
 		* Swing Phase(0.0 ~0.5) : ٸ ߿  ̵
 		* Stance Phase(0.5 ~1.0) : ٸ  ¤ ڷ о    
 	* @param bIsLeft    ٸ  (̸ Hip ȣ )
 	* @param CurrentStride  ũ ( = )
+	* @param OutLeg    [Hip, Thigh, Calf]
 */
-void UHexapodMovementComponent::ApplyLegMovement(int32 LegIndex, float Phase, bool bIsLeft, float CurrentStride) {
-	if (!HexapodRobot) return;
-	const TArray<FHexapodLeg>& Legs = HexapodRobot->GetLegs();
-	if (!Legs.IsValidIndex(LegIndex)) return;
-
+void UHexapodMovementComponent::ComputeLegTargets(const FHexapodGaitParams& Params, float Phase, bool bIsLeft, float CurrentStride, float* OutLeg) {
 	float xOffset = 0.f;
 	float zOffset = 0.f;
 
@@ -90,7 +136,7 @@ void UHexapodMovementComponent::ApplyLegMovement(int32 LegIndex, float Phase, bo
 	{
 		float t = Phase * 2.0f;  // 0~0.5 0~1 ȭ
 		xOffset = FMath::Lerp(-CurrentStride, CurrentStride, t);    //Hio յ Ⱦ
-		zOffset = FMath::Sin(t * PI) * LiftAngle;					//calf. Thigh Ͽ . 
+		zOffset = FMath::Sin(t * PI) * Params.LiftAngle;			//calf. Thigh Ͽ . 
 	}
 	else  // Stance Phase:  ¤ ڷ б
 	{
@@ -99,39 +145,27 @@ void UHexapodMovementComponent::ApplyLegMovement(int32 LegIndex, float Phase, bo
 		zOffset = 0.f;
 	}
 
-	const FHexapodLeg& Leg = Legs[LegIndex];
+	OutLeg[0] = bIsLeft ? xOffset : xOffset * -1.0f;  //  ȣ 
+	OutLeg[1] = zOffset;
+	OutLeg[2] = zOffset * 0.6f + 45; //
+}
 
-	if (bIsLeft)
-	{
-		SetJointTarget(Leg.HipConstraint, xOffset);
-		SetJointTarget(Leg.ThighConstraint, zOffset);
-		SetJointTarget(Leg.CalfConstraint, zOffset * 0.6f+45); //
-	}
-	else 
-	{
-		SetJointTarget(Leg.HipConstraint, xOffset * -1.0f);  //  ȣ 
-		SetJointTarget(Leg.ThighConstraint,zOffset);
-		SetJointTarget(Leg.CalfConstraint, zOffset * 0.6f + 45); //
+void UHexapodMovementComponent::ComputeStandingTargets(float* OutTargets) {
+	for (int32 i = 0; i < 6; i++) {
+		OutTargets[i * 3 + 0] = 0.f;
+		OutTargets[i * 3 + 1] = 0.f;
+		OutTargets[i * 3 + 2] = 60.f;
 	}
 }
 
 void UHexapodMovementComponent::ResetToCenter() {
 	if (!HexapodRobot) return; 
-	const TArray<FHexapodLeg>& Legs = HexapodRobot->GetLegs();
-
-	for (const FHexapodLeg& Leg : Legs) {
-		SetJointTarget(Leg.HipConstraint, 0.f);
-		SetJointTarget(Leg.ThighConstraint, 0.f);
-		SetJointTarget(Leg.CalfConstraint, 60.f);
-	}
-}
-
-void UHexapodMovementComponent::SetJointTarget(UPhysicsConstraintComponent* Constraint, float Target) {
-	if (!Constraint) return;
-	Constraint->SetAngularOrientationTarget(FRotator(0.f, Target, 0.f));  //Z ȸ ̱⿡,,,,,,,,,
+	float Targets[18];
+	ComputeStandingTargets(Targets);
+	HexapodRobot->SetConstraintTargets(Targets);
 }
 
 
 /* 
  
-*/
+*/
\ No newline at end of file
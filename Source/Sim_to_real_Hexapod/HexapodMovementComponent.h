@@ -6,6 +6,14 @@
 #include "Components/ActorComponent.h"
 #include "HexapodMovementComponent.generated.h"
 
+//  Ķ  - ġ / κ  
+struct FHexapodGaitParams
+{
+	float WalkSpeed = 1.0f;
+	float MaxStride = 25.0f;
+	float TurnRate  = 20.0f;
+	float LiftAngle = 40.0f;
+};
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SIM_TO_REAL_HEXAPOD_API UHexapodMovementComponent : public UActorComponent
@@ -23,8 +31,25 @@ protected:
 public:	
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-	void SetMoveForward(float Value) { InputDirection.X = Value; }
-	void SetMoveRight(float Value) { InputDirection.Y = Value; }
+	//Է    ȣ,  / ٲ  ƽ(Ǵ ġ) 
+	void SetMoveForward(float Value) { InputDirection.X = Value; OnInputChanged(); }
+	void SetMoveRight(float Value) { InputDirection.Y = Value; OnInputChanged(); }
+
+	bool IsWalking() const { return InputDirection.SizeSquared() > 0.01f; }
+	FVector2D GetInputDirection() const { return InputDirection; }
+	FHexapodGaitParams GetGaitParams() const;
+	///Ʃ׿ - Blueprint ⺻     Ķ ü
+	void SetGaitParams(const FHexapodGaitParams& Params);
+	float GetGaitPhase() const { return GaitPhase; }
+	void SetGaitPhase(float Phase) { GaitPhase = Phase; }
+
+	//ġ ý    true (ü ƽ )
+	void SetBatched(bool bInBatched);
+
+	//Է/  18  ǥ ( , Ŀ 忡 ȣ )
+	static void ComputeGaitTargets(const FHexapodGaitParams& Params, const FVector2D& Input, float GlobalPhase, float* OutTargets);
+	//ִ ڼ (Hip=0, Thigh=0, Calf=60)
+	static void ComputeStandingTargets(float* OutTargets);
 
 
 private:
@@ -51,12 +76,16 @@ private:
 	//   //0~1 ݺϴ  Ÿ̸.   Ŭ 
 	float GaitPhase = 0.0f;
 
+	bool bBatched = false;
+	bool bWasWalking = false;
+
+	// / ȯ  ü ƽ Ǵ ġ ýۿ ˸
+	void OnInputChanged();
+
 	/// stride   6 ٸ  
 	void CalculateStepAndMove(float GlobalPhase);
-	//ٸ 1 Swing/Stance    ǥ 
-	void ApplyLegMovement(int32 LegIndex, float Phase, bool bIsLeft, float CurrentStride);
+	//ٸ 1 Swing/Stance    ǥ 3
+	static void ComputeLegTargets(const FHexapodGaitParams& Params, float Phase, bool bIsLeft, float CurrentStride, float* OutLeg);
 	//Է     ʱ 
 	void ResetToCenter();
-	//Constraint ϳ ǥ  ϴ 
-	void SetJointTarget(class UPhysicsConstraintComponent* Constraint, float Target);
 };
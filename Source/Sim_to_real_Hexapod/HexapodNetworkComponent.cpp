@@ -3,12 +3,57 @@
 #include "HexapodNetworkComponent.h"
 #include "HexapodRobot.h"
 #include "HexapodMovementComponent.h"
+#include "HexapodSensorComponent.h"
+#include "HexapodSnapshotComponent.h"
+#include "HexapodBatchSubsystem.h"
+#include "HexapodDatasetSubsystem.h"
+#include "HexapodBootSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
+#include "Common/UdpSocketReceiver.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
 
 UHexapodNetworkComponent::UHexapodNetworkComponent()
 {
+	// 명령 처리: 물리 전, 데이터그램이 들어왔을 때만
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+	// OBS 응답: 물리 후, 응답 대기 중일 때만
+	ReplyTick.bCanEverTick = true;
+	ReplyTick.bStartWithTickEnabled = false;
+	ReplyTick.TickGroup = TG_PostPhysics;
+}
+
+void FHexapodReplyTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                            const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+		Target->SendPendingReplies();
+}
+
+FString FHexapodReplyTickFunction::DiagnosticMessage()
+{
+	return Target ? Target->GetFullName() + TEXT("[Reply]") : TEXT("UHexapodNetworkComponent[Reply]");
+}
+
+void UHexapodNetworkComponent::RegisterComponentTickFunctions(bool bRegister)
+{
+	Super::RegisterComponentTickFunctions(bRegister);
+
+	if (bRegister)
+	{
+		ReplyTick.Target = this;
+		if (SetupActorComponentTickFunction(&ReplyTick))
+			ReplyTick.SetTickFunctionEnable(false);
+	}
+	else if (ReplyTick.IsTickFunctionRegistered())
+	{
+		ReplyTick.UnRegisterTickFunction();
+	}
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -26,11 +71,31 @@ void UHexapodNetworkComponent::BeginPlay()
 		return;
 	}
 	MovementComp = HexapodRobot->FindComponentByClass<UHexapodMovementComponent>();
+	SensorComp   = HexapodRobot->FindComponentByClass<UHexapodSensorComponent>();
+	SnapshotComp = HexapodRobot->FindComponentByClass<UHexapodSnapshotComponent>();
+
+	// 응답은 이번 스텝의 관절 각도 캐시 / 센서 기록이 끝난 뒤
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		ReplyTick.AddPrerequisite(Batch, Batch->GetPostPhysicsTick());
+	if (SensorComp)
+		ReplyTick.AddPrerequisite(SensorComp, SensorComp->PrimaryComponentTick);
+
+	// 포트 0: 소켓 없이 사용 (스윕 등으로 대량 스폰한 로봇)
+	if (ListenPort <= 0)
+		return;
 
 	if (InitSocket())
+	{
 		UE_LOG(LogTemp, Log, TEXT("HexapodNetworkComponent: UDP 포트 %d 에서 수신 대기 중"), ListenPort);
+
+		// 첫 물리 스텝이 끝나야 명령을 받을 준비가 된 것 → 그때 READY
+		bAnnounceReady = true;
+		ReplyTick.SetTickFunctionEnable(true);
+	}
 	else
+	{
 		UE_LOG(LogTemp, Error, TEXT("HexapodNetworkComponent: UDP 포트 %d 열기 실패"), ListenPort);
+	}
 }
 
 void UHexapodNetworkComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -48,21 +113,45 @@ bool UHexapodNetworkComponent::InitSocket()
 	ISocketSubsystem* SocketSub = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
 	if (!SocketSub) return false;
 
-	ListenSocket = SocketSub->CreateSocket(NAME_DGram, TEXT("HexapodUDP"), false);
-	if (!ListenSocket) return false;
+	// 빠른 기동: 맵 로드 전부터 열려 있던 소켓을 넘겨받음 (BOOTING 응답을 받은 클라이언트 포함)
+	TArray<FIPv4Endpoint> Waiting;
+	if (UHexapodBootSubsystem* Boot = GetBootSubsystem())
+		ListenSocket = Boot->TakeListenSocket(ListenPort, Waiting);
 
-	TSharedRef<FInternetAddr> Addr = SocketSub->CreateInternetAddr();
-	Addr->SetAnyAddress();
-	Addr->SetPort(ListenPort);
+	if (!ListenSocket)
+	{
+		ListenSocket = SocketSub->CreateSocket(NAME_DGram, TEXT("HexapodUDP"), false);
+		if (!ListenSocket) return false;
+
+		TSharedRef<FInternetAddr> Addr = SocketSub->CreateInternetAddr();
+		Addr->SetAnyAddress();
+		Addr->SetPort(ListenPort);
+
+		ListenSocket->SetNonBlocking(true);
+		ListenSocket->SetReuseAddr(true);
 
-	ListenSocket->SetNonBlocking(true);
-	ListenSocket->SetReuseAddr(true);
+		if (!ListenSocket->Bind(*Addr)) return false;
+	}
+
+	for (const FIPv4Endpoint& Endpoint : Waiting)
+		FindOrAddClient(Endpoint.Address.ToString(), Endpoint.Port).bReadyPending = true;
 
-	return ListenSocket->Bind(*Addr);
+	// 수신 대기는 전용 스레드가 담당 (WaitTime 은 종료 반응 시간일 뿐, 데이터는 즉시 전달)
+	Receiver = new FUdpSocketReceiver(ListenSocket, FTimespan::FromMilliseconds(100),
+	                                  *FString::Printf(TEXT("HexapodUDP-%d"), ListenPort));
+	Receiver->OnDataReceived().BindUObject(this, &UHexapodNetworkComponent::OnDatagram);
+	Receiver->Start();
+	return true;
 }
 
 void UHexapodNetworkComponent::CloseSocket()
 {
+	// 수신 스레드를 먼저 멈춘 뒤 소켓 해제
+	if (Receiver)
+	{
+		delete Receiver;
+		Receiver = nullptr;
+	}
 	if (ListenSocket)
 	{
 		ListenSocket->Close();
@@ -72,51 +161,148 @@ void UHexapodNetworkComponent::CloseSocket()
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// 매 프레임 수신 처리
+// 수신: 수신 스레드 → 큐 → (깨어난) 틱에서 처리
 // ─────────────────────────────────────────────────────────────────────────────
 
+void UHexapodNetworkComponent::OnDatagram(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender)
+{
+	PendingPackets.Enqueue({ Data, Sender });
+
+	// 이미 깨우는 중이면 큐에만 추가 (프레임당 깨우기 1회)
+	if (!bWakePending.Exchange(true))
+	{
+		TWeakObjectPtr<UHexapodNetworkComponent> WeakThis(this);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+		{
+			if (UHexapodNetworkComponent* This = WeakThis.Get())
+				This->SetComponentTickEnabled(true);
+		});
+	}
+}
+
 void UHexapodNetworkComponent::TickComponent(float DeltaTime, ELevelTick TickType,
                                               FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	if (!ListenSocket) return;
 
-	uint32 PendingSize = 0;
-	while (ListenSocket->HasPendingData(PendingSize) && PendingSize > 0)
+	// 먼저 플래그를 내려야 비우는 도중 도착한 패킷이 다음 깨우기를 요청함
+	bWakePending = false;
+
+	FHexapodPendingPacket Pending;
+	while (PendingPackets.Dequeue(Pending))
 	{
-		// 버퍼 할당 (+1: null 종단 문자)
-		TArray<uint8> Buffer;
-		Buffer.SetNum(static_cast<int32>(PendingSize) + 1);
+		if (!Pending.Data.IsValid() || Pending.Data->Num() == 0) continue;
 
-		int32 BytesRead = 0;
-		TSharedRef<FInternetAddr> SenderAddr =
-			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Pending.Data->GetData()), Pending.Data->Num());
+		FString Packet(Converted.Length(), Converted.Get());
+		Packet.TrimEndInline();
 
-		if (ListenSocket->RecvFrom(Buffer.GetData(), Buffer.Num(), BytesRead, *SenderAddr)
-		    && BytesRead > 0)
-		{
-			Buffer[BytesRead] = 0;  // null 종단
-			FString Packet = UTF8_TO_TCHAR(reinterpret_cast<const char*>(Buffer.GetData()));
-			Packet.TrimEndInline();
+		ProcessPacket(Packet, Pending.Sender.Address.ToString(), Pending.Sender.Port);
+	}
 
-			const FString IP   = SenderAddr->ToString(false);
-			const int32   Port = SenderAddr->GetPort();
+	// 이번 틱에 받은 ACT 중 최신 것 하나만 이번 물리 스텝에 적용
+	CommitPendingAction();
 
-			ProcessPacket(Packet, IP, Port);
-		}
-	}
+	SetComponentTickEnabled(false);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // 수신 패킷 처리
+// 한 데이터그램 = '\n' 으로 구분된 명령 1개 이상, 응답(OBS)은 최대 1회
 // ─────────────────────────────────────────────────────────────────────────────
 
 void UHexapodNetworkComponent::ProcessPacket(const FString& Packet,
                                               const FString& SenderIP, int32 SenderPort)
+{
+	FHexapodObsClient& Client = FindOrAddClient(SenderIP, SenderPort);
+
+	TArray<FString> Lines;
+	Packet.ParseIntoArrayLines(Lines, true);
+
+	bool bReply = false;
+	for (const FString& Line : Lines)
+		bReply |= ProcessCommand(Line, Client);
+
+	// ACK / KEYFRAME 만 담긴 패킷을 제외한 모든 패킷에 대해 관측값 전송 (물리 스텝 후)
+	// 파이프라인 클라이언트는 매 스텝 스트림으로 받으므로 따로 응답하지 않음
+	if (bReply && bSendObservations && HexapodRobot && !Client.bStreaming)
+	{
+		Client.bReplyPending = true;
+		ReplyTick.SetTickFunctionEnable(true);
+	}
+}
+
+void UHexapodNetworkComponent::SendPendingReplies()
+{
+	if (bAnnounceReady)
+	{
+		bAnnounceReady = false;
+		if (UHexapodBootSubsystem* Boot = GetBootSubsystem())
+			Boot->MarkStage(EHexapodBootStage::FirstStep);
+	}
+
+	for (FHexapodObsClient& Client : Clients)
+	{
+		if (Client.bReadyPending)
+		{
+			Client.bReadyPending = false;
+			SendReady(Client);
+		}
+		if (!Client.bReplyPending && !Client.bStreaming) continue;
+		Client.bReplyPending = false;
+		SendObservation(Client);
+	}
+
+	// 스트리밍 중이면 매 스텝 깨어 있음
+	if (NumStreaming > 0)
+		AdvanceHold();
+	else
+		ReplyTick.SetTickFunctionEnable(false);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 파이프라인 행동 슬롯
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodNetworkComponent::CommitPendingAction()
+{
+	if (!bPendingAction || !HexapodRobot) return;
+	bPendingAction = false;
+
+	HexapodRobot->ApplyJointTargets(TArray<float>(PendingAction, 18));
+	AppliedSeq   = PendingSeq;
+	HeldSteps    = 0;
+	bHoldApplied = false;
+}
+
+void UHexapodNetworkComponent::AdvanceHold()
+{
+	// 다음 스텝도 같은 행동이 구동 (새 ACT 가 오면 PrePhysics 에서 교체)
+	HeldSteps++;
+	if (bHoldApplied || HeldSteps <= PipelineDepth || HoldPolicy != EHexapodHoldPolicy::Stand || !HexapodRobot)
+		return;
+
+	// 허용 지연 초과 → 서있는 자세로 대기 (OBS 의 HELD > D 로 클라이언트가 알 수 있음)
+	float Standing[18];
+	UHexapodMovementComponent::ComputeStandingTargets(Standing);
+	HexapodRobot->ApplyJointTargets(TArray<float>(Standing, 18));
+	bHoldApplied = true;
+}
+
+void UHexapodNetworkComponent::UpdateStreaming()
+{
+	NumStreaming = 0;
+	for (const FHexapodObsClient& C : Clients)
+		NumStreaming += C.bStreaming ? 1 : 0;
+	if (NumStreaming > 0)
+		ReplyTick.SetTickFunctionEnable(true);
+}
+
+bool UHexapodNetworkComponent::ProcessCommand(const FString& Line, FHexapodObsClient& Client)
 {
 	TArray<FString> Tokens;
-	Packet.ParseIntoArray(Tokens, TEXT(" "), true);
-	if (Tokens.Num() == 0) return;
+	Line.ParseIntoArray(Tokens, TEXT(" "), true);
+	if (Tokens.Num() == 0) return false;
 
 	const FString& Cmd = Tokens[0];
 
@@ -130,6 +316,36 @@ void UHexapodNetworkComponent::ProcessPacket(const FString& Packet,
 
 		HexapodRobot->ApplyJointTargets(Angles);
 	}
+	// ── ACT n a0 ... a17 : 순번 붙은 행동 → Pending 슬롯 ─────────────────────
+	else if (Cmd == TEXT("ACT") && Tokens.Num() == 20 && HexapodRobot)
+	{
+		// 늦게 도착한 이전 행동은 버림 (uint32 wrap-around 고려)
+		const uint32 Seq    = static_cast<uint32>(FCString::Strtoui64(*Tokens[1], nullptr, 10));
+		const uint32 Latest = bPendingAction ? PendingSeq : AppliedSeq;
+		if (static_cast<int32>(Seq - Latest) > 0)
+		{
+			for (int32 i = 0; i < 18; i++)
+				PendingAction[i] = FCString::Atof(*Tokens[i + 2]);
+			PendingSeq     = Seq;
+			bPendingAction = true;
+		}
+		Client.bTagAction = true;
+	}
+	// ── PIPELINE D [LAST|STAND] : 파이프라인 스텝 켜기/끄기 ───────────────────
+	else if (Cmd == TEXT("PIPELINE") && Tokens.Num() >= 2 && HexapodRobot)
+	{
+		PipelineDepth = FMath::Clamp(FCString::Atoi(*Tokens[1]), 0, 1000);
+		if (Tokens.Num() >= 3)
+			HoldPolicy = Tokens[2] == TEXT("STAND") ? EHexapodHoldPolicy::Stand : EHexapodHoldPolicy::Last;
+		Client.bStreaming = PipelineDepth > 0;
+		Client.bTagAction = true;
+
+		// 새 세션: 행동 순번은 클라이언트가 1 부터 다시 셈
+		PendingSeq = AppliedSeq = 0;
+		bPendingAction = bHoldApplied = false;
+		HeldSteps = 0;
+		UpdateStreaming();
+	}
 	// ── INPUT x y ─────────────────────────────────────────────────────────────
 	else if (Cmd == TEXT("INPUT") && Tokens.Num() == 3 && MovementComp)
 	{
@@ -148,46 +364,329 @@ void UHexapodNetworkComponent::ProcessPacket(const FString& Packet,
 			Standing[i * 3 + 2] = 60.f;  // Calf
 		}
 		HexapodRobot->ApplyJointTargets(Standing);
+
+		// 오프라인 데이터셋 기록 중이면 여기서 에피소드를 끊음
+		if (UHexapodDatasetSubsystem* Dataset = GetWorld()->GetSubsystem<UHexapodDatasetSubsystem>())
+			Dataset->MarkEpisodeEnd(HexapodRobot);
+	}
+	// ── ENCODING TEXT|Q16 ─────────────────────────────────────────────────────
+	else if (Cmd == TEXT("ENCODING") && Tokens.Num() == 2)
+	{
+		if (Tokens[1] == TEXT("Q16"))
+			Client.Encoding = EHexapodObsEncoding::Quantized16;
+		else if (Tokens[1] == TEXT("TEXT"))
+			Client.Encoding = EHexapodObsEncoding::Text;
+		Client.bHasAck = false;
+		Client.Sent.Reset();
+	}
+	// ── HISTORY K ─────────────────────────────────────────────────────────────
+	else if (Cmd == TEXT("HISTORY") && Tokens.Num() == 2)
+	{
+		// TEXT 64 × 24 값 ≈ 15 KB, Q16 ≈ 3 KB — UDP 데이터그램 한 개에 들어가는 범위로 제한
+		const int32 MaxStack = SensorComp ? FMath::Min(SensorComp->GetMaxStack(), HexapodObsCodec::MaxHistoryFrames) : 0;
+		Client.HistoryLength = FMath::Clamp(FCString::Atoi(*Tokens[1]), 0, MaxStack);
+		UpdateSensorRecording();
+	}
+	// ── FEET 0|1 ──────────────────────────────────────────────────────────────
+	else if (Cmd == TEXT("FEET") && Tokens.Num() == 2)
+	{
+		Client.bSendFeet = FCString::Atoi(*Tokens[1]) != 0;
+	}
+	// ── SAVE k / LOAD k : 물리 상태 슬롯 ────────────────────────────────────
+	else if (Cmd == TEXT("SAVE") && Tokens.Num() == 2 && SnapshotComp)
+	{
+		SnapshotComp->SaveSlot(FCString::Atoi(*Tokens[1]));
+	}
+	else if (Cmd == TEXT("LOAD") && Tokens.Num() == 2 && SnapshotComp)
+	{
+		SnapshotComp->RestoreSlot(FCString::Atoi(*Tokens[1]));
+	}
+	// ── ACK seq : 델타 기준 갱신, 응답 없음 ──────────────────────────────────
+	else if (Cmd == TEXT("ACK") && Tokens.Num() == 2)
+	{
+		const uint16 Seq = static_cast<uint16>(FCString::Atoi(*Tokens[1]));
+		const HexapodObsCodec::FQuantFrame* Frame = Client.Sent.Find(Seq);
+		// 순서가 뒤바뀐 오래된 ACK 는 무시 (기준은 앞으로만 이동)
+		if (Frame && (!Client.bHasAck || HexapodObsCodec::IsNewer(Seq, Client.Acked.Seq)))
+		{
+			Client.Acked  = *Frame;
+			Client.bHasAck = true;
+		}
+		return false;
+	}
+	// ── HELLO : 준비 확인, OBS 대신 READY ─────────────────────────────────────
+	else if (Cmd == TEXT("HELLO"))
+	{
+		Client.bReadyPending = true;
+		ReplyTick.SetTickFunctionEnable(true);
+		return false;
+	}
+	// ── KEYFRAME : 클라이언트가 베이스를 잃었을 때, 응답 없음 ───────────────
+	else if (Cmd == TEXT("KEYFRAME"))
+	{
+		Client.bHasAck = false;
+		return false;
 	}
 	// ── OBS_REQ (그 외 명령) : 아무 동작 없이 관측값만 반환 ──────────────────
 
-	// 모든 패킷에 대해 관측값 전송
-	if (bSendObservations && HexapodRobot)
-		SendObservation(SenderIP, SenderPort);
+	return true;
+}
+
+FHexapodObsClient& UHexapodNetworkComponent::FindOrAddClient(const FString& IP, int32 Port)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (FHexapodObsClient& C : Clients)
+	{
+		if (C.Port == Port && C.IP == IP)
+		{
+			C.LastSeenTime = Now;
+			return C;
+		}
+	}
+
+	// 빈 자리가 없으면 가장 오래 조용했던 클라이언트 자리를 재사용
+	int32 Index = INDEX_NONE;
+	if (Clients.Num() < FMath::Max(MaxClients, 1))
+	{
+		Index = Clients.AddDefaulted();
+	}
+	else
+	{
+		Index = 0;
+		for (int32 i = 1; i < Clients.Num(); i++)
+			if (Clients[i].LastSeenTime < Clients[Index].LastSeenTime) Index = i;
+		Clients[Index] = FHexapodObsClient();
+		UpdateSensorRecording();
+		UpdateStreaming();
+	}
+
+	FHexapodObsClient& C = Clients[Index];
+	C.IP           = IP;
+	C.Port         = Port;
+	C.LastSeenTime = Now;
+	C.Encoding     = DefaultEncoding;
+	C.bSendFeet    = bDefaultSendFeet;
+
+	bool bValid = false;
+	C.Addr = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+	C.Addr->SetIp(*IP, bValid);
+	C.Addr->SetPort(Port);
+	if (!bValid) C.Addr.Reset();
+
+	return C;
+}
+
+void UHexapodNetworkComponent::UpdateSensorRecording()
+{
+	if (!SensorComp) return;
+
+	bool bAnyHistory = false;
+	for (const FHexapodObsClient& C : Clients)
+		bAnyHistory |= C.HistoryLength > 0;
+	SensorComp->SetRecording(bAnyHistory);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // 관측값 전송 (UE5 → Python)
-// 포맷: "OBS a0 a1 ... a17 px py pz roll pitch yaw\n"
+// TEXT: "OBS a0 a1 ... a17 px py pz roll pitch yaw [FEET ...] [HIST K ...]\n"
+// Q16 : HexapodObsCodec 바이너리 프레임 (키프레임 또는 ACK 기준 델타)
 // ─────────────────────────────────────────────────────────────────────────────
 
-void UHexapodNetworkComponent::SendObservation(const FString& IP, int32 Port)
+UHexapodBootSubsystem* UHexapodNetworkComponent::GetBootSubsystem() const
+{
+	const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UHexapodBootSubsystem>() : nullptr;
+}
+
+void UHexapodNetworkComponent::SendReady(FHexapodObsClient& Client)
+{
+	if (!ListenSocket || !Client.Addr.IsValid()) return;
+
+	FString Msg = FString::Printf(TEXT("READY port=%d"), ListenPort);
+	if (const UHexapodBootSubsystem* Boot = GetBootSubsystem())
+		Msg += TEXT(" ") + Boot->GetBreakdown();
+	Msg += TEXT("\n");
+
+	const FTCHARToUTF8 Converted(*Msg);
+	int32 Sent = 0;
+	ListenSocket->SendTo(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length(), Sent, *Client.Addr);
+}
+
+void UHexapodNetworkComponent::GatherObservation(float* OutObs) const
+{
+	HexapodRobot->GetObservation(OutObs);
+}
+
+void UHexapodNetworkComponent::SendObservation(FHexapodObsClient& Client)
 {
-	if (!ListenSocket) return;
+	if (!ListenSocket || !Client.Addr.IsValid()) return;
+
+	float Obs[HexapodObsCodec::NumFields];
+	GatherObservation(Obs);
 
-	const TArray<float> Angles = HexapodRobot->GetJointAngles();
-	const FVector       Pos    = HexapodRobot->GetActorLocation();
-	const FRotator      Rot    = HexapodRobot->GetActorRotation();
+	if (Client.Encoding == EHexapodObsEncoding::Quantized16)
+		SendObservationQuantized(Client, Obs);
+	else
+		SendObservationText(Client, Obs);
+}
 
+void UHexapodNetworkComponent::SendObservationText(FHexapodObsClient& Client, const float* Obs)
+{
 	FString Msg = TEXT("OBS");
-	for (float A : Angles)
-		Msg += FString::Printf(TEXT(" %.4f"), A);
-	Msg += FString::Printf(TEXT(" %.4f %.4f %.4f %.4f %.4f %.4f\n"),
-	                       Pos.X, Pos.Y, Pos.Z, Rot.Roll, Rot.Pitch, Rot.Yaw);
+	for (int32 i = 0; i < HexapodObsCodec::NumFields; i++)
+		Msg += FString::Printf(TEXT(" %.4f"), Obs[i]);
+
+	// 이 관측을 만든 행동 (파이프라인에서는 보낸 행동보다 뒤처질 수 있음)
+	if (Client.bTagAction)
+		Msg += FString::Printf(TEXT(" SEQ %u HELD %d"), AppliedSeq, HeldSteps);
+
+	// 발끝 FK: 배치 서브시스템이 이번 물리 스텝에 계산해 둔 값
+	if (Client.bSendFeet)
+	{
+		float Feet[HexapodKinematics::FootFields];
+		HexapodRobot->GetFootObservation(Feet);
+		Msg += TEXT(" FEET");
+		for (int32 i = 0; i < HexapodKinematics::FootFields; i++)
+			Msg += FString::Printf(TEXT(" %.4f"), Feet[i]);
+	}
+
+	// 센서 히스토리: 링 버퍼 슬롯을 바로 읽어 직렬화 (중간 복사 없음)
+	if (Client.HistoryLength > 0 && SensorComp)
+	{
+		Msg += FString::Printf(TEXT(" HIST %d"), Client.HistoryLength);
+		for (int32 k = 0; k < Client.HistoryLength; k++)
+		{
+			const FHexapodObsView View = SensorComp->GetStacked(k);
+			for (int32 i = 0; i < HexapodObsFields; i++)
+				Msg += FString::Printf(TEXT(" %.4f"), View.Values ? View[i] : 0.f);
+		}
+	}
+	Msg += TEXT("\n");
 
 	const FTCHARToUTF8 Converted(*Msg);
 	const uint8* Data    = reinterpret_cast<const uint8*>(Converted.Get());
 	const int32  DataLen = Converted.Length();
 
-	ISocketSubsystem*       SocketSub = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-	TSharedPtr<FInternetAddr> Dest    = SocketSub->CreateInternetAddr();
-	bool bValid = false;
-	Dest->SetIp(*IP, bValid);
-	Dest->SetPort(Port);
+	int32 Sent = 0;
+	ListenSocket->SendTo(Data, DataLen, Sent, *Client.Addr);
+}
 
-	if (bValid)
+void UHexapodNetworkComponent::SendObservationQuantized(FHexapodObsClient& Client, const float* Obs)
+{
+	HexapodObsCodec::FQuantFrame Frame;
+	Frame.Seq = Client.NextSeq++;
+	HexapodObsCodec::Quantize(Obs, QuantScale, Frame.Values);
+
+	uint8 Buffer[HexapodObsCodec::MaxExtPacketBytes];
+	int32 Len = Client.bHasAck
+		? HexapodObsCodec::EncodeDelta(Frame, Client.Acked, Buffer)
+		: HexapodObsCodec::EncodeKey(Frame, Buffer);
+	Client.Sent.Store(Frame);
+	const int32 BodyLen = Len;
+
+	// 발끝 FK: TEXT 의 FEET 와 같은 21 필드를 'F' 블록으로
+	if (Client.bSendFeet)
 	{
-		int32 Sent = 0;
-		ListenSocket->SendTo(Data, DataLen, Sent, *Dest);
+		float Feet[HexapodKinematics::FootFields];
+		int16 FeetQ[HexapodKinematics::FootFields];
+		HexapodRobot->GetFootObservation(Feet);
+		for (int32 i = 0; i < HexapodKinematics::FootFields; i++)
+			FeetQ[i] = HexapodObsCodec::QuantizeValue(Feet[i], FootQuantScale.Step[i]);
+		Len = HexapodObsCodec::AppendExtBlock(Buffer, Len, HexapodObsCodec::BlockFeet, FeetQ, HexapodKinematics::FootFields);
 	}
+
+	// 센서 히스토리: TEXT 의 HIST 와 같은 순서를 'H' 블록으로 (델타 없이 매번 전체)
+	if (Client.HistoryLength > 0 && SensorComp)
+	{
+		int16 Stack[HexapodObsCodec::MaxHistoryFrames * HexapodObsCodec::NumFields];
+		for (int32 k = 0; k < Client.HistoryLength; k++)
+		{
+			const FHexapodObsView View = SensorComp->GetStacked(k);
+			for (int32 i = 0; i < HexapodObsCodec::NumFields; i++)
+				Stack[k * HexapodObsCodec::NumFields + i] = HexapodObsCodec::QuantizeValue(View.Values ? View[i] : 0.f, QuantScale.Step[i]);
+		}
+		Len = HexapodObsCodec::AppendExtBlock(Buffer, Len, HexapodObsCodec::BlockHistory, Stack,
+		                                      Client.HistoryLength * HexapodObsCodec::NumFields);
+	}
+	if (Len != BodyLen)
+		Len = HexapodObsCodec::FinishExt(Buffer, Len, BodyLen);
+
+	if (Client.bTagAction)
+		Len = HexapodObsCodec::AppendActionTag(Buffer, Len, static_cast<uint16>(AppliedSeq),
+		                                       static_cast<uint16>(FMath::Min(HeldSteps, 65535)));
+
+	int32 Sent = 0;
+	ListenSocket->SendTo(Buffer, Len, Sent, *Client.Addr);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 인코딩 처리량 벤치마크 — 콘솔: Hexapod.BenchObsCodec [프레임 수]
+// 보행 중과 비슷한 합성 궤적으로 Q16 키/델타 인코딩 속도와 평균 크기 측정
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void BenchObsCodec(const TArray<FString>& Args)
+{
+	const int32 NumFrames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200000;
+	const HexapodObsCodec::FQuantScale Scale = HexapodObsCodec::FQuantScale::Default();
+
+	HexapodObsCodec::FQuantFrame Base, Frame, Decoded;
+	uint8 Buffer[HexapodObsCodec::MaxPacketBytes];
+	float Obs[HexapodObsCodec::NumFields];
+
+	auto MakeObs = [&Obs](int32 Step)
+	{
+		const float T = Step * 0.002f;  // 500 Hz
+		for (int32 i = 0; i < 18; i++)
+			Obs[i] = 25.f * FMath::Sin(2.f * PI * T + i * 0.35f) + ((i % 3) == 2 ? 60.f : 0.f);
+		Obs[18] = 10.f * T;  Obs[19] = 0.5f * FMath::Sin(T);  Obs[20] = 12.f;
+		Obs[21] = 1.5f * FMath::Sin(7.f * T); Obs[22] = 1.f * FMath::Cos(7.f * T); Obs[23] = 3.f * T;
+	};
+
+	int64 KeyBytes = 0, DeltaBytes = 0;
+	float MaxError = 0.f;
+
+	// 키프레임
+	double Start = FPlatformTime::Seconds();
+	for (int32 n = 0; n < NumFrames; n++)
+	{
+		MakeObs(n);
+		Frame.Seq = static_cast<uint16>(n);
+		HexapodObsCodec::Quantize(Obs, Scale, Frame.Values);
+		KeyBytes += HexapodObsCodec::EncodeKey(Frame, Buffer);
+	}
+	const double KeySec = FPlatformTime::Seconds() - Start;
+
+	// 델타 (직전 프레임을 ACK 했다고 가정) + 디코딩 검증
+	MakeObs(0);
+	HexapodObsCodec::Quantize(Obs, Scale, Base.Values);
+	Start = FPlatformTime::Seconds();
+	for (int32 n = 1; n < NumFrames; n++)
+	{
+		MakeObs(n);
+		Frame.Seq = static_cast<uint16>(n);
+		HexapodObsCodec::Quantize(Obs, Scale, Frame.Values);
+		const int32 Len = HexapodObsCodec::EncodeDelta(Frame, Base, Buffer);
+		DeltaBytes += Len;
+
+		if (HexapodObsCodec::Decode(Buffer, Len, &Base, Decoded))
+		{
+			for (int32 i = 0; i < HexapodObsCodec::NumFields; i++)
+				MaxError = FMath::Max(MaxError, FMath::Abs(Decoded.Values[i] * Scale.Step[i] - Obs[i]));
+		}
+		Base = Frame;
+	}
+	const double DeltaSec = FPlatformTime::Seconds() - Start;
+
+	UE_LOG(LogTemp, Log, TEXT("BenchObsCodec: %d frames"), NumFrames);
+	UE_LOG(LogTemp, Log, TEXT("  Key   : %.1f ns/frame, %.1f bytes/frame"),
+	       KeySec * 1e9 / NumFrames, static_cast<double>(KeyBytes) / NumFrames);
+	UE_LOG(LogTemp, Log, TEXT("  Delta : %.1f ns/frame (encode+decode), %.1f bytes/frame, max error %.4f"),
+	       DeltaSec * 1e9 / FMath::Max(NumFrames - 1, 1),
+	       static_cast<double>(DeltaBytes) / FMath::Max(NumFrames - 1, 1), MaxError);
 }
+
+static FAutoConsoleCommand GBenchObsCodecCommand(
+	TEXT("Hexapod.BenchObsCodec"),
+	TEXT("Q16 관측값 인코딩 처리량 측정. 인자: [프레임 수]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchObsCodec));
@@ -4,10 +4,83 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Containers/Queue.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/ArrayReader.h"
+#include "HexapodObsCodec.h"
 #include "HexapodNetworkComponent.generated.h"
 
 // 전방 선언 — 헤더 의존성 최소화
 class FSocket;
+class FInternetAddr;
+class FUdpSocketReceiver;
+class UHexapodNetworkComponent;
+class UHexapodBootSubsystem;
+
+/** 관측값(OBS) 송신 인코딩 — 클라이언트별로 선택 */
+UENUM(BlueprintType)
+enum class EHexapodObsEncoding : uint8
+{
+	Text        UMETA(DisplayName = "Text (%.4f)"),
+	Quantized16 UMETA(DisplayName = "Quantized int16 + Delta"),
+};
+
+/** 파이프라인 스텝에서 허용 지연(PIPELINE D)을 넘도록 새 행동이 오지 않을 때 */
+UENUM(BlueprintType)
+enum class EHexapodHoldPolicy : uint8
+{
+	Last  UMETA(DisplayName = "Repeat last action"),
+	Stand UMETA(DisplayName = "Standing pose"),
+};
+
+/** 송신 대상 클라이언트 하나의 상태 (주소 + 인코딩 + 델타 베이스라인) */
+struct FHexapodObsClient
+{
+	FString IP;
+	int32   Port = 0;
+	TSharedPtr<FInternetAddr> Addr;     // 등록 시 1회 생성 → 송신마다 재할당 없음
+	double  LastSeenTime = 0.0;
+
+	EHexapodObsEncoding Encoding = EHexapodObsEncoding::Text;
+	int32  HistoryLength = 0;           // 응답에 붙일 센서 히스토리 스택 길이
+	bool   bSendFeet = false;           // 응답에 발끝 FK 필드 추가 (FEET 1, TEXT 는 FEET 토큰 / Q16 은 'F' 블록)
+	bool   bReplyPending = false;       // 이번 물리 스텝 후 OBS 전송 대기
+	bool   bReadyPending = false;       // 이번 물리 스텝 후 READY 전송 대기 (HELLO / 기동 중 접속)
+	bool   bStreaming    = false;       // PIPELINE: 요청 없이 매 물리 스텝 OBS 전송
+	bool   bTagAction    = false;       // OBS 에 반영된 행동 seq 태그 (ACT / PIPELINE 사용 시)
+
+	// Quantized16 전용
+	uint16 NextSeq  = 0;
+	bool   bHasAck  = false;
+	HexapodObsCodec::FQuantFrame   Acked;   // 델타 기준 프레임 (클라이언트가 ACK 한 마지막 프레임)
+	HexapodObsCodec::FFrameHistory Sent;    // ACK 조회용 최근 송신 프레임
+};
+
+/** 수신 스레드 → 게임 스레드로 넘기는 데이터그램 하나 */
+struct FHexapodPendingPacket
+{
+	FArrayReaderPtr Data;
+	FIPv4Endpoint   Sender;
+};
+
+/** OBS 응답 전용 PostPhysics 틱 — 응답이 대기 중일 때만 켜짐 */
+USTRUCT()
+struct FHexapodReplyTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UHexapodNetworkComponent* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHexapodReplyTickFunction> : public TStructOpsTypeTraitsBase2<FHexapodReplyTickFunction>
+{
+	enum { WithCopy = false };
+};
 
 /**
  * UHexapodNetworkComponent
@@ -19,9 +92,43 @@ class FSocket;
  *  "JOINTS a0 a1 ... a17"   : 18개 관절 목표 각도 (도) → ApplyJointTargets()
  *  "INPUT  x  y"            : 이동 입력 → SetMoveForward / SetMoveRight
  *  "RESET"                  : 서있는 자세 (Hip=0, Thigh=0, Calf=60)
+ *  "ENCODING TEXT|Q16"      : 이 클라이언트의 OBS 인코딩 선택 (Q16 선택 시 키프레임부터)
+ *  "ACK seq"                : Q16 프레임 seq 수신 확인 → 이후 델타의 기준 (응답 없음)
+ *  "KEYFRAME"               : 델타 기준 초기화, 다음 OBS 는 키프레임 (응답 없음)
+ *  "HISTORY K"              : 이후 응답에 지연/노이즈 적용된 최근 K 프레임 스택 추가 (0 = 끔, 최대 64)
+ *  "FEET 0|1"               : 응답의 발끝 FK 필드 끄기/켜기 (기본 끔, TEXT / Q16 공통)
+ *  "SAVE k" / "LOAD k"      : 물리 상태를 슬롯 k 에 저장 / 복원 (UHexapodSnapshotComponent)
+ *  "HELLO"                  : 준비 확인 → READY 응답 (OBS 없음)
+ *  "ACT n a0 ... a17"       : 순번 n 이 붙은 관절 목표 → 행동 슬롯 (이전 n 이하는 무시)
+ *  "PIPELINE D [LAST|STAND]": 파이프라인 스텝 켜기 (D = 허용 지연 스텝 수, 0 = 끔)
+ *
+ *  한 데이터그램에 여러 명령을 '\n' 으로 묶어 보낼 수 있음 (응답은 1회).
+ *  예) "ACK 41\nJOINTS ...", "LOAD 2\nJOINTS ..." (복원 직후 같은 스텝에 행동 적용)
  *
  * ── 송신 프로토콜 (UE5 → Python) ──────────────────────────────────────────
- *  "OBS a0...a17 px py pz roll pitch yaw"  : 관절 각도 + 위치/자세
+ *  "OBS a0...a17 px py pz roll pitch yaw"  : 관절 각도 + 위치/자세 (TEXT)
+ *      [" SEQ n HELD h"]                   : ACT/PIPELINE 사용 시 — 이 관측이 반영한 행동 순번, 그 행동을 유지한 스텝 수
+ *      [" FEET" + 21 값]                   : FEET 1 설정 시, 발끝 xyz × 6 + 접지 마스크 + 안정 여유 + 지지 넓이 (HexapodKinematics.h)
+ *      [" HIST K" + K × 24 값]             : HISTORY 설정 시, 최신(지연 적용) → 과거 순
+ *  바이너리 Q16 프레임                     : HexapodObsCodec.h 참조 (Q16, SEQ/HELD 는 끝 4 bytes 태그,
+ *                                            FEET 는 'F', HIST 는 'H' 확장 블록)
+ *  "READY port=P total_ms=.. engine_ms=.. ..." : HELLO 응답, 또는 기동 중 접속한 클라이언트에게 첫 물리 스텝 뒤 1회
+ *                                            (기동 단계별 시간, UHexapodBootSubsystem)
+ *  "BOOTING <단계> <ms>"                   : 빠른 기동(-HexapodFastBoot) 중 로봇 스폰 전 — 명령은 무시됨
+ *
+ * ── 스케줄 ────────────────────────────────────────────────────────────────
+ *  수신 스레드(FUdpSocketReceiver)가 소켓을 기다리다 데이터그램이 오면 큐에 넣고 틱을 깨움.
+ *  TG_PrePhysics  : 큐 비우기 → 명령 반영 → 다시 잠듦 (빈 소켓 폴링 없음)
+ *  TG_PostPhysics : 명령이 반영된 물리 스텝 결과로 OBS 응답 (ReplyTick)
+ *                   → 응답 관측값은 항상 명령 이후 상태 (한 프레임 밀리지 않음)
+ *
+ * ── 파이프라인 스텝 (PIPELINE D) ───────────────────────────────────────────
+ *  요청/응답 방식은 클라이언트가 응답을 기다리는 동안 정책 계산을 못 하고, 정책 계산 중에는 행동이 없음.
+ *  파이프라인에서는 시뮬레이션이 클라이언트를 기다리지 않음:
+ *   - 행동 슬롯 이중 버퍼: 수신 중인 ACT 는 Pending 에 덮어쓰고, PrePhysics 틱 끝에서 최신 것만 Applied 로 교체
+ *   - 새 행동이 없으면 스텝 t+1 은 마지막 행동 그대로. D 스텝을 넘게 없으면 HoldPolicy (STAND = 서있는 자세)
+ *   - 매 물리 스텝 OBS 를 요청 없이 전송, "SEQ n HELD h" 로 어떤 행동의 결과인지 표시
+ *  클라이언트는 관측 t 로 행동을 계산하는 동안 시뮬레이션이 스텝 t+1 을 진행 → 처리량 ≈ max(시뮬레이션, 정책)
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class SIM_TO_REAL_HEXAPOD_API UHexapodNetworkComponent : public UActorComponent
@@ -35,8 +142,12 @@ public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
 	                           FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
+	/** ReplyTick: 대기 중인 클라이언트에 OBS 전송 */
+	void SendPendingReplies();
 
-	/** Python 에서 수신하는 UDP 포트 */
+	/** Python 에서 수신하는 UDP 포트 (0 = 소켓 열지 않음) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
 	int32 ListenPort = 7777;
 
@@ -44,14 +155,75 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
 	bool bSendObservations = true;
 
+	/** 새 클라이언트의 기본 OBS 인코딩 (ENCODING 명령으로 클라이언트별 변경) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+	EHexapodObsEncoding DefaultEncoding = EHexapodObsEncoding::Text;
+
+	/** 새 클라이언트의 OBS 에 발끝 FK 필드를 붙일지 (기본 끔 → 기존 TEXT 25 토큰 / Q16 54 bytes 클라이언트 그대로, FEET 1 로 켬) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+	bool bDefaultSendFeet = false;
+
+	/** 파이프라인에서 허용 지연을 넘어 행동이 끊겼을 때 (PIPELINE 명령 인자로 변경) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network")
+	EHexapodHoldPolicy HoldPolicy = EHexapodHoldPolicy::Last;
+
+	/** 동시에 추적하는 클라이언트 수 (초과 시 가장 오래된 클라이언트 교체) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network", meta = (ClampMin = "1"))
+	int32 MaxClients = 8;
+
 private:
 	FSocket* ListenSocket = nullptr;
+	FUdpSocketReceiver* Receiver = nullptr;
+
+	// 수신 스레드(생산자 1) → 게임 스레드(소비자 1)
+	TQueue<FHexapodPendingPacket, EQueueMode::Spsc> PendingPackets;
+	TAtomic<bool> bWakePending { false };
+
+	FHexapodReplyTickFunction ReplyTick;
+
+	TArray<FHexapodObsClient> Clients;
+	HexapodObsCodec::FQuantScale QuantScale = HexapodObsCodec::FQuantScale::Default();
+	HexapodObsCodec::FFootQuantScale FootQuantScale = HexapodObsCodec::FFootQuantScale::Default();
 
 	class AHexapodRobot*             HexapodRobot = nullptr;
 	class UHexapodMovementComponent* MovementComp = nullptr;
+	class UHexapodSensorComponent*   SensorComp   = nullptr;
+	class UHexapodSnapshotComponent* SnapshotComp = nullptr;
+
+	/** 첫 물리 스텝 뒤 기동 완료 기록 + 대기 중인 클라이언트에게 READY */
+	bool bAnnounceReady = false;
+
+	// 행동 슬롯 (이중 버퍼): 수신 → Pending, PrePhysics 틱 끝 → Applied
+	float  PendingAction[18] = {};
+	uint32 PendingSeq   = 0;
+	bool   bPendingAction = false;
+	uint32 AppliedSeq   = 0;
+	int32  HeldSteps    = 0;       // Applied 행동이 이어서 구동한 물리 스텝 수 (0 = 이번 스텝에 새로 적용)
+	bool   bHoldApplied = false;   // 허용 지연을 넘어 HoldPolicy 적용 중
+	int32  PipelineDepth = 0;
+	int32  NumStreaming  = 0;
 
 	bool InitSocket();
 	void CloseSocket();
+	/** 수신 스레드에서 호출 */
+	void OnDatagram(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender);
 	void ProcessPacket(const FString& Packet, const FString& SenderIP, int32 SenderPort);
-	void SendObservation(const FString& IP, int32 Port);
+	/** 명령 한 줄 처리. 관측값 응답이 필요한 명령이면 true */
+	bool ProcessCommand(const FString& Line, FHexapodObsClient& Client);
+	FHexapodObsClient& FindOrAddClient(const FString& IP, int32 Port);
+	/** Pending 행동을 Applied 로 교체 (새 행동이 있을 때만) */
+	void CommitPendingAction();
+	/** 파이프라인: 스텝마다 유지 카운트 증가, 허용 지연을 넘으면 HoldPolicy 적용 */
+	void AdvanceHold();
+	void UpdateStreaming();
+	/** HISTORY 를 요청한 클라이언트가 있을 때만 센서 기록 */
+	void UpdateSensorRecording();
+
+	UHexapodBootSubsystem* GetBootSubsystem() const;
+	void SendReady(FHexapodObsClient& Client);
+	void SendObservation(FHexapodObsClient& Client);
+	void SendObservationText(FHexapodObsClient& Client, const float* Obs);
+	void SendObservationQuantized(FHexapodObsClient& Client, const float* Obs);
+	/** 관절 18 + 위치 3 + 자세 3 → OBS 필드 순서대로 채움 */
+	void GatherObservation(float* OutObs) const;
 };
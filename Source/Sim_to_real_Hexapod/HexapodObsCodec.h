@@ -0,0 +1,363 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+// UE 의존성 없는 순수 C++ 헤더 — 엔진 모듈과 외부 클라이언트가 같은 코드를 공유
+#include <cstdint>
+#include <cmath>
+
+#include "HexapodKinematics.h"
+
+/**
+ * HexapodObsCodec
+ *
+ * OBS 관측값(24 float)을 int16 고정소수점으로 양자화하고,
+ * 클라이언트가 ACK 한 마지막 프레임 대비 델타로 압축하는 바이너리 인코딩.
+ * 인코딩/디코딩 모두 호출자가 넘긴 고정 버퍼만 사용 (힙 할당 없음).
+ *
+ * ── 패킷 레이아웃 (little-endian) ────────────────────────────────────────
+ *  Key   : 'Q' 0 seq:u16 base:u16 | int16 × 24                      (54 bytes)
+ *  Delta : 'Q' 1 seq:u16 base:u16 | changed:u24 wide:u24 | 값 …     (12 ~ 60 bytes)
+ *          changed 비트가 켜진 필드만 기록. wide 비트면 2 bytes, 아니면 1 byte.
+ *          델타는 uint16 모듈러 연산 → 복원값은 키프레임과 비트 단위로 동일.
+ *  Tag   : 종류 바이트에 TagBit(0x80) 이 켜져 있으면 끝에 action:u16 held:u16 (+4 bytes)
+ *          파이프라인 스텝(PIPELINE)에서 이 관측이 반영한 행동 seq 와 그 행동을 유지한 스텝 수.
+ *  Ext   : 종류 바이트에 ExtBit(0x40) 이 켜져 있으면 본문 뒤(태그 앞)에 확장 블록 영역
+ *          [id:u8 count:u16 | int16 × count] … ext_bytes:u16
+ *          ext_bytes 는 블록들의 총 길이 → 끝에서 거꾸로 본문 끝을 찾음. 모르는 id 는 건너뜀.
+ *          'H' : 센서 히스토리 K × 24 (HISTORY, FQuantScale 스텝, 최신 → 과거)
+ *          'F' : 발끝 FK 21 필드 (FEET 1, HexapodKinematics.h 순서, FFootQuantScale 스텝)
+ *          델타 압축은 본문(OBS 24 필드)에만 적용, 블록은 매번 전체 값.
+ *
+ *  전체 레이아웃: header | body | [blocks … ext_bytes] | [tag]
+ *
+ * ── 필드 순서 (텍스트 OBS 와 동일) ────────────────────────────────────────
+ *  [0..17] 관절 각도(도)  [18..20] 위치(cm)  [21..23] roll pitch yaw(도)
+ */
+namespace HexapodObsCodec
+{
+	constexpr int32_t NumFields      = 24;
+	constexpr uint8_t Magic          = 'Q';
+	constexpr int32_t HeaderBytes    = 6;
+	constexpr uint8_t TagBit         = 0x80;
+	constexpr int32_t TagBytes       = 4;
+	constexpr int32_t MaxPacketBytes = HeaderBytes + 6 + NumFields * 2 + TagBytes;
+	constexpr int32_t HistorySize    = 16;   // 송신/수신 측이 보관하는 최근 프레임 수 (2의 거듭제곱)
+
+	constexpr uint8_t ExtBit            = 0x40;
+	constexpr int32_t BlockHeaderBytes  = 3;    // id:u8 count:u16
+	constexpr uint8_t BlockHistory      = 'H';
+	constexpr uint8_t BlockFeet         = 'F';
+	constexpr int32_t MaxHistoryFrames  = 64;   // HISTORY K 상한 (64 × 24 × 2 ≈ 3 KB)
+	constexpr int32_t MaxExtPacketBytes = MaxPacketBytes + 2
+	                                    + BlockHeaderBytes + MaxHistoryFrames * NumFields * 2
+	                                    + BlockHeaderBytes + HexapodKinematics::FootFields * 2;
+
+	enum class EFrameType : uint8_t
+	{
+		Key   = 0,
+		Delta = 1,
+	};
+
+	/** 필드별 양자화 스텝 (LSB 하나가 나타내는 물리량) */
+	struct FQuantScale
+	{
+		float Step[NumFields];
+
+		static FQuantScale Default()
+		{
+			FQuantScale S{};
+			for (int32_t i = 0; i < 18; i++) S.Step[i] = 0.01f;   // 관절: 0.01° (±327°)
+			for (int32_t i = 18; i < 21; i++) S.Step[i] = 0.1f;   // 위치: 1 mm (±32.7 m)
+			for (int32_t i = 21; i < 24; i++) S.Step[i] = 0.01f;  // 자세: 0.01°
+			return S;
+		}
+	};
+
+	/** 'F' 블록 필드별 양자화 스텝 */
+	struct FFootQuantScale
+	{
+		float Step[HexapodKinematics::FootFields];
+
+		static FFootQuantScale Default()
+		{
+			FFootQuantScale S{};
+			for (int32_t i = 0; i < 18; i++) S.Step[i] = 0.01f;   // 발끝 xyz: 0.1 mm (±327 cm)
+			S.Step[18] = 1.f;                                     // 접지 마스크: 정수 그대로
+			S.Step[19] = 0.01f;                                   // 안정 여유: 0.1 mm
+			S.Step[20] = 0.1f;                                    // 지지 넓이: 0.1 cm² (±3276 cm²)
+			return S;
+		}
+	};
+
+	/** 양자화된 관측 프레임 하나 */
+	struct FQuantFrame
+	{
+		uint16_t Seq = 0;
+		int16_t  Values[NumFields] = {};
+	};
+
+	/** seq % HistorySize 슬롯에 최근 프레임을 보관하는 고정 크기 링 */
+	struct FFrameHistory
+	{
+		FQuantFrame Frames[HistorySize];
+		bool        bValid[HistorySize] = {};
+
+		void Store(const FQuantFrame& Frame)
+		{
+			const int32_t Slot = Frame.Seq & (HistorySize - 1);
+			Frames[Slot] = Frame;
+			bValid[Slot] = true;
+		}
+
+		const FQuantFrame* Find(uint16_t Seq) const
+		{
+			const int32_t Slot = Seq & (HistorySize - 1);
+			return (bValid[Slot] && Frames[Slot].Seq == Seq) ? &Frames[Slot] : nullptr;
+		}
+
+		void Reset()
+		{
+			for (bool& b : bValid) b = false;
+		}
+	};
+
+	/** a 가 b 보다 최신 seq 인지 (uint16 wrap-around 고려) */
+	inline bool IsNewer(uint16_t A, uint16_t B)
+	{
+		return static_cast<int16_t>(static_cast<uint16_t>(A - B)) > 0;
+	}
+
+	inline int16_t QuantizeValue(float V, float Step)
+	{
+		float Q = std::nearbyint(V / Step);
+		if (!(Q == Q)) Q = 0.f;   // NaN (물리 발산) → 0. 그대로 캐스트하면 정의되지 않은 동작
+		Q = Q < -32768.f ? -32768.f : (Q > 32767.f ? 32767.f : Q);
+		return static_cast<int16_t>(Q);
+	}
+
+	inline void Quantize(const float* In, const FQuantScale& Scale, int16_t* Out)
+	{
+		for (int32_t i = 0; i < NumFields; i++)
+			Out[i] = QuantizeValue(In[i], Scale.Step[i]);
+	}
+
+	inline void Dequantize(const int16_t* In, const FQuantScale& Scale, float* Out)
+	{
+		for (int32_t i = 0; i < NumFields; i++)
+			Out[i] = static_cast<float>(In[i]) * Scale.Step[i];
+	}
+
+	// ─────────────────────────────────────────────────────────────────────────
+	// 바이트 헬퍼
+	// ─────────────────────────────────────────────────────────────────────────
+
+	inline void WriteU16(uint8_t* P, uint16_t V) { P[0] = static_cast<uint8_t>(V); P[1] = static_cast<uint8_t>(V >> 8); }
+	inline uint16_t ReadU16(const uint8_t* P)    { return static_cast<uint16_t>(P[0] | (P[1] << 8)); }
+	inline void WriteU24(uint8_t* P, uint32_t V) { P[0] = static_cast<uint8_t>(V); P[1] = static_cast<uint8_t>(V >> 8); P[2] = static_cast<uint8_t>(V >> 16); }
+	inline uint32_t ReadU24(const uint8_t* P)    { return P[0] | (P[1] << 8) | (static_cast<uint32_t>(P[2]) << 16); }
+
+	inline void WriteHeader(uint8_t* Out, EFrameType Type, uint16_t Seq, uint16_t BaseSeq)
+	{
+		Out[0] = Magic;
+		Out[1] = static_cast<uint8_t>(Type);
+		WriteU16(Out + 2, Seq);
+		WriteU16(Out + 4, BaseSeq);
+	}
+
+	// ─────────────────────────────────────────────────────────────────────────
+	// 인코딩 — Out 은 MaxPacketBytes 이상 (확장 블록을 붙이면 MaxExtPacketBytes). 반환값: 기록한 바이트 수
+	// ─────────────────────────────────────────────────────────────────────────
+
+	inline int32_t EncodeKey(const FQuantFrame& Frame, uint8_t* Out)
+	{
+		WriteHeader(Out, EFrameType::Key, Frame.Seq, Frame.Seq);
+		uint8_t* P = Out + HeaderBytes;
+		for (int32_t i = 0; i < NumFields; i++, P += 2)
+			WriteU16(P, static_cast<uint16_t>(Frame.Values[i]));
+		return static_cast<int32_t>(P - Out);
+	}
+
+	inline int32_t EncodeDelta(const FQuantFrame& Frame, const FQuantFrame& Base, uint8_t* Out)
+	{
+		WriteHeader(Out, EFrameType::Delta, Frame.Seq, Base.Seq);
+
+		uint32_t Changed = 0;
+		uint32_t Wide    = 0;
+		uint8_t* P = Out + HeaderBytes + 6;
+		for (int32_t i = 0; i < NumFields; i++)
+		{
+			const int32_t D = static_cast<int32_t>(Frame.Values[i]) - static_cast<int32_t>(Base.Values[i]);
+			if (D == 0) continue;
+
+			Changed |= 1u << i;
+			if (D >= -128 && D <= 127)
+			{
+				*P++ = static_cast<uint8_t>(static_cast<int8_t>(D));
+			}
+			else
+			{
+				Wide |= 1u << i;
+				WriteU16(P, static_cast<uint16_t>(Frame.Values[i] - Base.Values[i]));
+				P += 2;
+			}
+		}
+		WriteU24(Out + HeaderBytes,     Changed);
+		WriteU24(Out + HeaderBytes + 3, Wide);
+		return static_cast<int32_t>(P - Out);
+	}
+
+	/** 인코딩된 프레임 끝에 행동 태그를 붙임. Packet 은 Len + TagBytes 이상. 반환값: 새 길이 */
+	inline int32_t AppendActionTag(uint8_t* Packet, int32_t Len, uint16_t ActionSeq, uint16_t Held)
+	{
+		Packet[1] |= TagBit;
+		WriteU16(Packet + Len,     ActionSeq);
+		WriteU16(Packet + Len + 2, Held);
+		return Len + TagBytes;
+	}
+
+	/**
+	 * 본문 뒤에 확장 블록 하나를 붙임 (태그보다 먼저). Packet 은 Len + BlockHeaderBytes + Count * 2 이상.
+	 * 블록을 다 붙였으면 FinishExt 로 영역을 닫아야 함. 반환값: 새 길이
+	 */
+	inline int32_t AppendExtBlock(uint8_t* Packet, int32_t Len, uint8_t Id, const int16_t* Values, int32_t Count)
+	{
+		Packet[1] |= ExtBit;
+		Packet[Len] = Id;
+		WriteU16(Packet + Len + 1, static_cast<uint16_t>(Count));
+		uint8_t* P = Packet + Len + BlockHeaderBytes;
+		for (int32_t i = 0; i < Count; i++, P += 2)
+			WriteU16(P, static_cast<uint16_t>(Values[i]));
+		return static_cast<int32_t>(P - Packet);
+	}
+
+	/** 확장 영역 길이를 기록. BodyLen 은 첫 블록을 붙이기 전 길이. 반환값: 새 길이 */
+	inline int32_t FinishExt(uint8_t* Packet, int32_t Len, int32_t BodyLen)
+	{
+		WriteU16(Packet + Len, static_cast<uint16_t>(Len - BodyLen));
+		return Len + 2;
+	}
+
+	// ─────────────────────────────────────────────────────────────────────────
+	// 디코딩
+	// ─────────────────────────────────────────────────────────────────────────
+
+	/** 본문 끝과 확장 블록 영역 끝 (ext_bytes 앞) 오프셋. 확장이 없으면 둘 다 태그 앞. 길이가 안 맞으면 false */
+	inline bool GetSections(const uint8_t* Data, int32_t Len, int32_t& OutBodyEnd, int32_t& OutExtEnd)
+	{
+		const int32_t End = Len - ((Data[1] & TagBit) ? TagBytes : 0);
+		OutBodyEnd = OutExtEnd = End;
+		if (!(Data[1] & ExtBit)) return End >= HeaderBytes;
+		if (End < HeaderBytes + 2) return false;
+		OutExtEnd  = End - 2;
+		OutBodyEnd = OutExtEnd - ReadU16(Data + OutExtEnd);
+		return OutBodyEnd >= HeaderBytes;
+	}
+
+	/** 헤더만 읽어 프레임 종류와 seq/base 를 꺼냄. 형식이 아니면 false */
+	inline bool PeekHeader(const uint8_t* Data, int32_t Len, EFrameType& OutType, uint16_t& OutSeq, uint16_t& OutBaseSeq)
+	{
+		int32_t BodyEnd, ExtEnd;
+		if (Len < HeaderBytes || Data[0] != Magic)
+			return false;
+		const uint8_t Type = static_cast<uint8_t>(Data[1] & ~(TagBit | ExtBit));
+		if (Type > static_cast<uint8_t>(EFrameType::Delta) || !GetSections(Data, Len, BodyEnd, ExtEnd))
+			return false;
+		OutType    = static_cast<EFrameType>(Type);
+		OutSeq     = ReadU16(Data + 2);
+		OutBaseSeq = ReadU16(Data + 4);
+		return true;
+	}
+
+	/** 행동 태그가 붙은 프레임이면 꺼냄 (PeekHeader 통과한 패킷). 없으면 false */
+	inline bool ReadActionTag(const uint8_t* Data, int32_t Len, uint16_t& OutActionSeq, uint16_t& OutHeld)
+	{
+		if (Len < HeaderBytes + TagBytes || !(Data[1] & TagBit)) return false;
+		OutActionSeq = ReadU16(Data + Len - TagBytes);
+		OutHeld      = ReadU16(Data + Len - 2);
+		return true;
+	}
+
+	/**
+	 * 패킷 하나를 복원. Delta 프레임이면 Base 에 base seq 프레임을 넘겨야 함
+	 * (History.Find(BaseSeq)). 길이/형식/베이스 불일치 시 false.
+	 */
+	inline bool Decode(const uint8_t* Data, int32_t Len, const FQuantFrame* Base, FQuantFrame& Out)
+	{
+		EFrameType Type;
+		uint16_t Seq, BaseSeq;
+		if (!PeekHeader(Data, Len, Type, Seq, BaseSeq)) return false;
+
+		int32_t BodyEnd, ExtEnd;
+		GetSections(Data, Len, BodyEnd, ExtEnd);
+		const uint8_t* P   = Data + HeaderBytes;
+		const uint8_t* End = Data + BodyEnd;
+
+		if (Type == EFrameType::Key)
+		{
+			if (End - P != NumFields * 2) return false;
+			for (int32_t i = 0; i < NumFields; i++, P += 2)
+				Out.Values[i] = static_cast<int16_t>(ReadU16(P));
+			Out.Seq = Seq;
+			return true;
+		}
+
+		if (!Base || Base->Seq != BaseSeq || End - P < 6) return false;
+		const uint32_t Changed = ReadU24(P);
+		const uint32_t Wide    = ReadU24(P + 3);
+		P += 6;
+
+		int16_t Values[NumFields];
+		for (int32_t i = 0; i < NumFields; i++)
+		{
+			uint16_t V = static_cast<uint16_t>(Base->Values[i]);
+			if (Changed & (1u << i))
+			{
+				if (Wide & (1u << i))
+				{
+					if (End - P < 2) return false;
+					V = static_cast<uint16_t>(V + ReadU16(P));
+					P += 2;
+				}
+				else
+				{
+					if (End - P < 1) return false;
+					V = static_cast<uint16_t>(V + static_cast<int8_t>(*P));
+					P += 1;
+				}
+			}
+			Values[i] = static_cast<int16_t>(V);
+		}
+		if (P != End) return false;
+
+		for (int32_t i = 0; i < NumFields; i++) Out.Values[i] = Values[i];
+		Out.Seq = Seq;
+		return true;
+	}
+
+	/**
+	 * 확장 블록 Id 를 찾아 int16 값을 Out 에 복사 (PeekHeader 통과한 패킷).
+	 * 반환값: 값 개수. 블록이 없거나 MaxCount 를 넘거나 형식이 깨졌으면 -1
+	 */
+	inline int32_t FindExtBlock(const uint8_t* Data, int32_t Len, uint8_t Id, int16_t* Out, int32_t MaxCount)
+	{
+		int32_t P, End;
+		if (!(Data[1] & ExtBit) || !GetSections(Data, Len, P, End)) return -1;
+		while (End - P >= BlockHeaderBytes)
+		{
+			const uint8_t BlockId = Data[P];
+			const int32_t Count   = ReadU16(Data + P + 1);
+			P += BlockHeaderBytes;
+			if (End - P < Count * 2) return -1;
+			if (BlockId == Id)
+			{
+				if (Count > MaxCount) return -1;
+				for (int32_t i = 0; i < Count; i++)
+					Out[i] = static_cast<int16_t>(ReadU16(Data + P + i * 2));
+				return Count;
+			}
+			P += Count * 2;
+		}
+		return -1;
+	}
+}
@@ -0,0 +1,424 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodProfileSubsystem.h"
+#include "HexapodRobot.h"
+#include "HexapodMovementComponent.h"
+#include "HexapodBatchSubsystem.h"
+#include "HexapodBootSubsystem.h"
+#include "Chaos/PBDJointConstraintData.h"
+#include "Chaos/PBDJointConstraintTypes.h"
+#include "Engine/GameInstance.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsEngine/PhysicsConstraintComponent.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "TimerManager.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectHash.h"
+
+static double HexapodUsedPhysicalMB()
+{
+	return FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 생명주기
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodProfileSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UHexapodProfileSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 명령줄 실행: -HexapodProfile=<최대 로봇 수> [-HexapodProfileFrames=] [-HexapodProfileHz=] [-HexapodProfileIdle]
+	const TCHAR* CmdLine = FCommandLine::Get();
+	FHexapodProfileSettings CmdSettings;
+	if (!FParse::Value(CmdLine, TEXT("HexapodProfile="), CmdSettings.MaxRobots))
+		return;
+	FParse::Value(CmdLine, TEXT("HexapodProfileFrames="), CmdSettings.MeasureFrames);
+	FParse::Value(CmdLine, TEXT("HexapodProfileHz="), CmdSettings.TargetHz);
+	CmdSettings.bWalk = !FParse::Param(CmdLine, TEXT("HexapodProfileIdle"));
+
+	// 빠른 기동은 StartPlay 뒤 메시 로드가 끝나야 로봇을 스폰 → 그 뒤 배치 스텝까지 미룸
+	if (UHexapodBatchSubsystem* Batch = InWorld.GetSubsystem<UHexapodBatchSubsystem>())
+	{
+		PendingSettings    = CmdSettings;
+		PendingStartHandle = Batch->OnPostBatch().AddUObject(this, &UHexapodProfileSubsystem::StartPendingProfile);
+	}
+}
+
+void UHexapodProfileSubsystem::StartPendingProfile(float DeltaTime)
+{
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	const UHexapodBootSubsystem* Boot = GameInstance ? GameInstance->GetSubsystem<UHexapodBootSubsystem>() : nullptr;
+	if (Boot && Boot->IsFastBoot() && !Boot->HasStage(EHexapodBootStage::RobotsSpawned))
+		return;
+
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->OnPostBatch().Remove(PendingStartHandle);
+	PendingStartHandle.Reset();
+
+	// 시작 시 GC 를 돌리므로 배치 콜백 밖(다음 프레임 타이머)에서. 실패해도 종료 (CI 가 기다리지 않도록, 종료 코드 1)
+	GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+	{
+		bQuitWhenDone = true;
+		if (!StartProfile(PendingSettings))
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+	}));
+}
+
+void UHexapodProfileSubsystem::Deinitialize()
+{
+	if (FPhysScene_Chaos* Scene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+	{
+		Scene->OnPhysScenePreTick.Remove(PhysicsPreTickHandle);
+		Scene->OnPhysScenePostTick.Remove(PhysicsPostTickHandle);
+	}
+	Super::Deinitialize();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 시작 / 종료
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodProfileSubsystem::StartProfile(const FHexapodProfileSettings& InSettings)
+{
+	UWorld* World = GetWorld();
+	UHexapodBatchSubsystem* Batch = World ? World->GetSubsystem<UHexapodBatchSubsystem>() : nullptr;
+	if (IsRunning() || !Batch)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HexapodProfile: 이미 실행 중입니다 (Hexapod.ProfileScaling cancel)."));
+		return false;
+	}
+
+	Settings = InSettings;
+	Settings.MaxRobots     = FMath::Clamp(Settings.MaxRobots, 1, 1024);
+	Settings.MeasureFrames = FMath::Max(Settings.MeasureFrames, 10);
+	Settings.TargetHz      = FMath::Max(Settings.TargetHz, 1.f);
+
+	// 1, 2, 4, … (마지막은 MaxRobots)
+	Stages.Reset();
+	for (int32 N = 1; N < Settings.MaxRobots; N *= 2)
+		Stages.Add(N);
+	Stages.Add(Settings.MaxRobots);
+
+	Samples.Reset(Stages.Num());
+	StageIndex = 0;
+	ExitStatus = 1;
+	ResultPath.Reset();
+
+	// 이미 있는 로봇(배치/빠른 기동)과 겹치지 않게 전체 경계 상자의 +X 쪽에 줄지어 배치
+	FBox Existing(ForceInit);
+	float SpawnZ = 50.f;
+	int32 ExistingRobots = 0;
+	for (TActorIterator<AHexapodRobot> It(World); It; ++It)
+	{
+		FVector Origin, Extent;
+		It->GetActorBounds(false, Origin, Extent);
+		Existing += FBox(Origin - Extent, Origin + Extent);
+		SpawnZ = It->GetActorLocation().Z;
+		ExistingRobots++;
+	}
+	SpawnOrigin = Existing.IsValid
+		? FVector(Existing.Max.X + Settings.Spacing, Existing.GetCenter().Y, SpawnZ)
+		: FVector(0.f, 0.f, SpawnZ);
+
+	// 기준값: 로봇을 스폰하기 전
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	BaselineUsedMB  = HexapodUsedPhysicalMB();
+	BaselineObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+	if (FPhysScene_Chaos* Scene = World->GetPhysicsScene())
+	{
+		PhysicsPreTickHandle  = Scene->OnPhysScenePreTick.AddUObject(this, &UHexapodProfileSubsystem::OnPhysicsPreTick);
+		PhysicsPostTickHandle = Scene->OnPhysScenePostTick.AddUObject(this, &UHexapodProfileSubsystem::OnPhysicsPostTick);
+	}
+
+	// 측정은 배치 계산(관절 각도/보상)이 끝난 물리 스텝 직후
+	PostBatchHandle = Batch->OnPostBatch().AddUObject(this, &UHexapodProfileSubsystem::ProfileUpdate);
+	bRunning = true;
+
+	UE_LOG(LogTemp, Log, TEXT("HexapodProfile: 로봇 1~%d 대 %d 단계, 단계당 %d 프레임, 기준 %.0f Hz (%s)"),
+	       Settings.MaxRobots, Stages.Num(), Settings.MeasureFrames, Settings.TargetHz,
+	       Settings.bWalk ? TEXT("보행") : TEXT("정지"));
+	if (ExistingRobots > 0)
+		UE_LOG(LogTemp, Warning, TEXT("HexapodProfile: 맵에 있던 로봇 %d 대가 모든 단계 시간에 포함됩니다"), ExistingRobots);
+
+	if (!BeginStage())
+	{
+		UE_LOG(LogTemp, Error, TEXT("HexapodProfile: 로봇 스폰 실패"));
+		Cleanup();
+		return false;
+	}
+	return true;
+}
+
+void UHexapodProfileSubsystem::CancelProfile()
+{
+	if (!IsRunning()) return;
+	UE_LOG(LogTemp, Log, TEXT("HexapodProfile: 취소 (%d / %d 단계 완료)"), Samples.Num(), Stages.Num());
+	if (Samples.Num() > 0)
+		WriteResults();
+	Cleanup();
+}
+
+void UHexapodProfileSubsystem::Cleanup()
+{
+	if (UHexapodBatchSubsystem* Batch = GetWorld() ? GetWorld()->GetSubsystem<UHexapodBatchSubsystem>() : nullptr)
+		Batch->OnPostBatch().Remove(PostBatchHandle);
+	PostBatchHandle.Reset();
+	bRunning = false;
+
+	if (FPhysScene_Chaos* Scene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+	{
+		Scene->OnPhysScenePreTick.Remove(PhysicsPreTickHandle);
+		Scene->OnPhysScenePostTick.Remove(PhysicsPostTickHandle);
+	}
+	PhysicsPreTickHandle.Reset();
+	PhysicsPostTickHandle.Reset();
+
+	for (AHexapodRobot* Robot : ProfileRobots)
+		if (IsValid(Robot)) Robot->Destroy();
+	ProfileRobots.Reset();
+
+	if (bQuitWhenDone)
+		FPlatformMisc::RequestExitWithStatus(false, ExitStatus);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 단계: 스폰 → 워밍업 → 메모리 측정 → 프레임 측정
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodProfileSubsystem::BeginStage()
+{
+	// 이전 단계 로봇은 그대로 두고 모자란 만큼만 추가
+	const int32 Before = ProfileRobots.Num();
+	SpawnRobots(Stages[StageIndex] - Before);
+	if (ProfileRobots.Num() == Before)
+		return false;
+
+	StageFrames    = 0;
+	LastFrameTime  = 0.0;
+	FramePhysicsMs = 0.0;
+	PhysicsMsSum   = 0.0;
+	FrameMsSamples.Reset(Settings.MeasureFrames);
+	return true;
+}
+
+void UHexapodProfileSubsystem::SpawnRobots(int32 Count)
+{
+	UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>();
+
+	for (int32 n = 0; n < Count; n++)
+	{
+		// 전방(로컬 -Y)과 수직인 X 축으로 나란히, 한 줄이 차면 뒤(+Y)로 다음 줄
+		const int32 k = ProfileRobots.Num();
+		const FVector Offset(Settings.Spacing * (k % Settings.RowLength), Settings.RowSpacing * (k / Settings.RowLength), 0.f);
+		AHexapodRobot* Robot = Batch->SpawnHeadlessRobot(nullptr, FTransform(FRotator::ZeroRotator, SpawnOrigin + Offset));
+		if (!Robot) break;
+
+		if (Settings.bWalk)
+			if (UHexapodMovementComponent* Movement = Robot->FindComponentByClass<UHexapodMovementComponent>())
+				Movement->SetMoveForward(1.f);
+		ProfileRobots.Add(Robot);
+	}
+}
+
+void UHexapodProfileSubsystem::MeasureMemory(FHexapodProfileSample& Sample) const
+{
+	Sample.UObjects  = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Sample.ProcessMB = HexapodUsedPhysicalMB() - BaselineUsedMB;
+
+	TArray<UObject*> Objects;
+	for (AHexapodRobot* Robot : ProfileRobots)
+	{
+		// 로봇 + 컴포넌트 등 하위 객체 (메시 등 공유 에셋은 제외)
+		Objects.Reset();
+		Objects.Add(Robot);
+		GetObjectsWithOuter(Robot, Objects, true);
+		for (UObject* Object : Objects)
+		{
+			FArchiveCountMem Count(Object);
+			Sample.RobotObjectBytes += Count.GetMax() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+		Sample.RobotObjects += Objects.Num();
+
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(Robot);
+		for (const UPrimitiveComponent* Primitive : Primitives)
+		{
+			if (!Primitive->GetBodyInstance() || !Primitive->GetBodyInstance()->IsValidBodyInstance()) continue;
+			FResourceSizeEx BodySize(EResourceSizeMode::Exclusive);
+			Primitive->GetBodyInstance()->GetBodyInstanceResourceSizeEx(BodySize);
+			Sample.BodyBytes += BodySize.GetTotalMemoryBytes();
+			Sample.Bodies++;
+		}
+
+		// 구속: 게임 스레드 FConstraintInstance + Chaos 조인트 (게임 스레드 FJointConstraint, 솔버 쪽 설정 사본).
+		// Chaos 는 조인트별 할당 크기를 노출하지 않으므로 구조체 크기로 추정 (솔버 배열 여유분은 제외)
+		TInlineComponentArray<UPhysicsConstraintComponent*> Constraints(Robot);
+		for (const UPhysicsConstraintComponent* Constraint : Constraints)
+		{
+			if (!Constraint->ConstraintInstance.IsValidConstraintInstance()) continue;
+			Sample.ConstraintBytes += sizeof(FConstraintInstance) + sizeof(Chaos::FJointConstraint) + sizeof(Chaos::FPBDJointSettings);
+			Sample.Constraints++;
+		}
+	}
+}
+
+void UHexapodProfileSubsystem::ProfileUpdate(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double FrameMs = LastFrameTime > 0.0 ? (Now - LastFrameTime) * 1000.0 : 0.0;
+	const double PhysicsMs = FramePhysicsMs;
+	LastFrameTime  = Now;
+	FramePhysicsMs = 0.0;
+
+	StageFrames++;
+	if (StageFrames <= Settings.WarmupFrames) return;
+
+	// 측정 직전 메모리 (스폰 직후 할당이 정리된 뒤). 이 프레임은 측정 시간 때문에 버림
+	if (StageFrames == Settings.WarmupFrames + 1)
+	{
+		FHexapodProfileSample& Sample = Samples.AddDefaulted_GetRef();
+		Sample.Robots = ProfileRobots.Num();
+		MeasureMemory(Sample);
+		LastFrameTime = FPlatformTime::Seconds();
+		return;
+	}
+
+	FrameMsSamples.Add((float)FrameMs);
+	PhysicsMsSum += PhysicsMs;
+	if (FrameMsSamples.Num() >= Settings.MeasureFrames)
+		EndStage();
+}
+
+void UHexapodProfileSubsystem::EndStage()
+{
+	FHexapodProfileSample& Sample = Samples.Last();
+	const int32 Frames = FrameMsSamples.Num();
+
+	double Sum = 0.0;
+	for (float Ms : FrameMsSamples)
+		Sum += Ms;
+	FrameMsSamples.Sort();
+
+	Sample.FrameMs    = Sum / Frames;
+	Sample.FrameP95Ms = FrameMsSamples[FMath::Min(Frames - 1, FMath::FloorToInt(Frames * 0.95f))];
+	Sample.PhysicsMs  = PhysicsMsSum / Frames;
+	Sample.GameMs     = FMath::Max(0.0, Sample.FrameMs - Sample.PhysicsMs);
+	Sample.bRealtime  = Sample.FrameMs <= 1000.0 / Settings.TargetHz;
+
+	const double N = FMath::Max(Sample.Robots, 1);
+	UE_LOG(LogTemp, Log, TEXT("HexapodProfile: 로봇 %d 대 — 프레임 %.3f ms (p95 %.3f), 물리 %.3f ms, 게임 %.3f ms, 로봇당 %.1f µs / %.1f KB 객체 / %.2f MB 프로세스%s"),
+	       Sample.Robots, Sample.FrameMs, Sample.FrameP95Ms, Sample.PhysicsMs, Sample.GameMs,
+	       Sample.FrameMs * 1000.0 / N, Sample.RobotObjectBytes / 1024.0 / N, Sample.ProcessMB / N,
+	       Sample.bRealtime ? TEXT("") : TEXT("  [실시간 아님]"));
+
+	// 스폰이 더 안 되면 (액터 한도 등) 거기까지만
+	if (++StageIndex >= Stages.Num() || !BeginStage())
+		FinishProfile();
+}
+
+void UHexapodProfileSubsystem::FinishProfile()
+{
+	// 실시간을 유지한 최대 로봇 수 (처음 깨진 단계 직전까지)
+	int32 MaxRealtime = 0;
+	for (const FHexapodProfileSample& Sample : Samples)
+	{
+		if (!Sample.bRealtime) break;
+		MaxRealtime = Sample.Robots;
+	}
+
+	const FHexapodProfileSample* Breaking = Samples.FindByPredicate([](const FHexapodProfileSample& S) { return !S.bRealtime; });
+	if (Breaking)
+		UE_LOG(LogTemp, Log, TEXT("HexapodProfile: %.0f Hz 실시간 최대 %d 대 (%d 대에서 프레임 %.3f ms > %.3f ms)"),
+		       Settings.TargetHz, MaxRealtime, Breaking->Robots, Breaking->FrameMs, 1000.0 / Settings.TargetHz);
+	else
+		UE_LOG(LogTemp, Log, TEXT("HexapodProfile: %.0f Hz 실시간 %d 대까지 유지 (한계는 더 위)"),
+		       Settings.TargetHz, MaxRealtime);
+
+	ExitStatus = WriteResults() ? 0 : 1;
+	Cleanup();
+}
+
+bool UHexapodProfileSubsystem::WriteResults()
+{
+	FString Csv = TEXT("robots,uobjects,uobjects_added_per_robot,objects_per_robot,object_kb_per_robot,bodies_per_robot,constraints_per_robot,body_kb_per_robot,constraint_kb_per_robot,")
+	              TEXT("process_mb,process_mb_per_robot,frame_ms,frame_p95_ms,physics_ms,game_ms,")
+	              TEXT("physics_us_per_robot,game_us_per_robot,steps_per_s,realtime\n");
+	for (const FHexapodProfileSample& S : Samples)
+	{
+		if (S.FrameMs <= 0.0) continue;   // 측정 도중 취소된 단계
+		const double N = FMath::Max(S.Robots, 1);
+		Csv += FString::Printf(TEXT("%d,%d,%.1f,%.1f,%.2f,%.1f,%.1f,%.2f,%.2f,%.2f,%.3f,%.4f,%.4f,%.4f,%.4f,%.2f,%.2f,%.1f,%d\n"),
+		                       S.Robots, S.UObjects, (S.UObjects - BaselineObjects) / N, S.RobotObjects / N, S.RobotObjectBytes / 1024.0 / N,
+		                       S.Bodies / N, S.Constraints / N, S.BodyBytes / 1024.0 / N, S.ConstraintBytes / 1024.0 / N,
+		                       S.ProcessMB, S.ProcessMB / N, S.FrameMs, S.FrameP95Ms, S.PhysicsMs, S.GameMs,
+		                       S.PhysicsMs * 1000.0 / N, S.GameMs * 1000.0 / N, 1000.0 / S.FrameMs, S.bRealtime ? 1 : 0);
+	}
+
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("HexapodProfile") /
+	                     FString::Printf(TEXT("Scaling_%s.csv"), *FDateTime::Now().ToString());
+	if (!FFileHelper::SaveStringToFile(Csv, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HexapodProfile: 결과 저장 실패 %s"), *Path);
+		return false;
+	}
+	UE_LOG(LogTemp, Log, TEXT("HexapodProfile: 결과 저장 %s"), *Path);
+	ResultPath = Path;
+	return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 물리 씬 시간 (StartPhysics 의 PreTick → EndPhysics 의 PostTick)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodProfileSubsystem::OnPhysicsPreTick(FPhysScene_Chaos* Scene, float DeltaSeconds)
+{
+	PhysicsStart = FPlatformTime::Seconds();
+}
+
+void UHexapodProfileSubsystem::OnPhysicsPostTick(FChaosScene* Scene)
+{
+	if (PhysicsStart > 0.0)
+		FramePhysicsMs += (FPlatformTime::Seconds() - PhysicsStart) * 1000.0;
+	PhysicsStart = 0.0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 콘솔 명령: Hexapod.ProfileScaling [최대 로봇 수] [측정 프레임] [목표 Hz] [walk|idle] | cancel
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void ProfileScaling(const TArray<FString>& Args, UWorld* World)
+{
+	UHexapodProfileSubsystem* Profile = World ? World->GetSubsystem<UHexapodProfileSubsystem>() : nullptr;
+	if (!Profile) return;
+
+	if (Args.Num() > 0 && Args[0].ToLower() == TEXT("cancel"))
+	{
+		Profile->CancelProfile();
+		return;
+	}
+
+	FHexapodProfileSettings Settings;
+	if (Args.Num() > 0) Settings.MaxRobots     = FMath::Max(1, FCString::Atoi(*Args[0]));
+	if (Args.Num() > 1) Settings.MeasureFrames = FMath::Max(10, FCString::Atoi(*Args[1]));
+	if (Args.Num() > 2) Settings.TargetHz      = FMath::Max(1.f, FCString::Atof(*Args[2]));
+	if (Args.Num() > 3) Settings.bWalk         = Args[3].ToLower() != TEXT("idle");
+
+	Profile->StartProfile(Settings);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GProfileScalingCommand(
+	TEXT("Hexapod.ProfileScaling"),
+	TEXT("로봇 수별 메모리/CPU 비용과 실시간 한계 측정 → CSV. 인자: [최대 로봇 수] [측정 프레임] [목표 Hz] [walk|idle], 또는 cancel"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ProfileScaling));
@@ -0,0 +1,144 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HexapodProfileSubsystem.generated.h"
+
+class AHexapodRobot;
+class FChaosScene;
+class FPhysScene_Chaos;
+
+/** 스케일링 측정 설정 (콘솔 명령 Hexapod.ProfileScaling 또는 -HexapodProfile= 에서 채움) */
+struct FHexapodProfileSettings
+{
+	int32 MaxRobots     = 64;       // 1, 2, 4, … MaxRobots 단계로 늘림
+	int32 WarmupFrames  = 100;      // 스폰 후 측정 전 버리는 프레임 (안정화 + 캐시)
+	int32 MeasureFrames = 500;      // 단계당 측정 프레임
+	float TargetHz      = 500.f;    // 실시간 판정 기준 물리 스텝 주기
+	bool  bWalk         = true;     // 로봇을 걷게 해서 배치 계산까지 포함한 부하로 측정
+	float Spacing       = 200.f;    // 로봇 간 옆 간격 (cm)
+	int32 RowLength     = 32;       // 한 줄에 세우는 로봇 수 (다음 줄은 +Y 로 RowSpacing 뒤)
+	float RowSpacing    = 1000.f;
+};
+
+/** 로봇 수 한 단계의 측정 결과 */
+struct FHexapodProfileSample
+{
+	int32 Robots = 0;
+
+	// 메모리 (측정 시작 시점)
+	int32  UObjects        = 0;     // 전체 UObject 수
+	int32  RobotObjects    = 0;     // 스폰한 로봇 + 하위 객체 수 (합계)
+	int64  RobotObjectBytes = 0;    // 위 객체들의 직렬화 크기 + 리소스 크기 (합계)
+	int32  Bodies          = 0;     // 유효한 물리 바디 수 (합계)
+	int32  Constraints     = 0;     // 유효한 물리 구속 수 (합계)
+	int64  BodyBytes       = 0;     // 물리 바디 리소스 크기 (합계)
+	int64  ConstraintBytes = 0;     // 물리 구속 크기 (합계, Chaos 조인트는 구조체 크기로 추정)
+	double ProcessMB       = 0.0;   // 측정 시작 전 대비 프로세스 사용 메모리 증가량
+
+	// 시간 (측정 프레임 평균, ms)
+	double FrameMs    = 0.0;        // 프레임 간 벽시계 시간
+	double FrameP95Ms = 0.0;
+	double PhysicsMs  = 0.0;        // 물리 씬 PreTick → PostTick (StartPhysics ~ EndPhysics)
+	double GameMs     = 0.0;        // 프레임 - 물리 (게임 스레드 틱 + 엔진 루프)
+
+	bool bRealtime = false;         // FrameMs <= 1000 / TargetHz
+};
+
+/**
+ * UHexapodProfileSubsystem
+ *
+ * 로봇 한 대당 메모리/CPU 비용과 실시간 한계 로봇 수 측정 (학습 노드 크기 산정용).
+ * 로봇을 1, 2, 4, … MaxRobots 대까지 늘려 가며(UDP 포트 없이 스폰) 단계마다:
+ *  - 메모리: UObject 수, 로봇 하위 객체 수/크기, 물리 바디·구속 수와 크기, 프로세스 메모리 증가량
+ *  - 시간: 프레임 시간(평균/p95), 물리 씬 스텝 시간, 나머지(게임 스레드) 시간 → 로봇당 값
+ *  - 실시간 판정: 평균 프레임 시간 <= 1000 / TargetHz (프레임당 물리 스텝 1회 기준)
+ * 끝나면 CSV: Saved/HexapodProfile/Scaling_<시각>.csv, 실시간을 유지한 최대 로봇 수를 로그로 출력.
+ * 로봇은 UHexapodBatchSubsystem::SpawnHeadlessRobot 으로 기존 로봇들의 경계 상자 옆(+X)에 줄지어 스폰,
+ * 측정은 UHexapodBatchSubsystem::OnPostBatch (측정 중에만 등록).
+ *
+ * 프레임 제한 없이 고정 스텝으로 돌려야 프레임 시간 = 스텝 비용:
+ *  UnrealEditor-Cmd <프로젝트> /Engine/Maps/Entry?game=HexapodFastBoot -game -nullrhi -nosound
+ *                   -benchmark -fps=500 -HexapodProfile=128 [-HexapodProfileFrames=500] [-HexapodProfileIdle]
+ *  (명령줄로 시작하면 끝난 뒤 종료 → CI/노드 점검에서 그대로 사용. 종료 코드: CSV 저장까지 끝나면 0,
+ *   시작/스폰 실패·취소·저장 실패면 1. 빠른 기동은 이때 네트워크 로봇을 스폰하지 않고,
+ *   측정은 RobotsSpawned 단계 뒤 첫 배치 스텝에서 시작)
+ *
+ * 자동화 테스트: Hexapod.Profile.Scaling (HexapodProfileTest.cpp) — 작은 설정으로 단계 완료와 CSV 저장 확인
+ *  UnrealEditor-Cmd <프로젝트> -nullrhi -ExecCmds="Automation RunTests Hexapod.Profile; Quit"
+ *
+ * 콘솔: Hexapod.ProfileScaling [최대 로봇 수] [측정 프레임] [목표 Hz] [walk|idle]
+ *       Hexapod.ProfileScaling cancel
+ */
+UCLASS()
+class SIM_TO_REAL_HEXAPOD_API UHexapodProfileSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/** 측정 시작. 이미 실행 중이면 false */
+	bool StartProfile(const FHexapodProfileSettings& InSettings);
+	void CancelProfile();
+	bool IsRunning() const { return bRunning; }
+
+	/** 마지막 측정 결과 (단계별 표본, 단계 수, 저장한 CSV 경로 — 저장 전이면 빈 문자열) */
+	const TArray<FHexapodProfileSample>& GetSamples() const { return Samples; }
+	int32 GetNumStages() const { return Stages.Num(); }
+	const FString& GetResultPath() const { return ResultPath; }
+
+	void ProfileUpdate(float DeltaTime);
+
+	/** 명령줄 측정: 빠른 기동 로봇 스폰이 끝난 뒤 첫 배치 스텝에서 시작 */
+	void StartPendingProfile(float DeltaTime);
+
+private:
+	UPROPERTY(Transient)
+	TArray<AHexapodRobot*> ProfileRobots;
+
+	FVector SpawnOrigin = FVector::ZeroVector;
+
+	FHexapodProfileSettings Settings;
+	FHexapodProfileSettings PendingSettings;     // 명령줄 설정 (시작 대기 중)
+
+	TArray<int32> Stages;                        // 단계별 로봇 수
+	TArray<FHexapodProfileSample> Samples;
+	int32  StageIndex  = 0;
+	int32  StageFrames = 0;                      // 이번 단계에서 지난 프레임 (워밍업 포함)
+	bool   bRunning    = false;
+	bool   bQuitWhenDone = false;                // 명령줄로 시작 → 끝나면 종료
+	uint8  ExitStatus    = 1;                    // 명령줄 종료 코드 (CSV 저장까지 끝나야 0)
+	FString ResultPath;
+
+	double BaselineUsedMB = 0.0;
+	int32  BaselineObjects = 0;                  // 스폰 전 UObject 수 (uobjects_added_per_robot 기준)
+
+	// 프레임 시간
+	double LastFrameTime  = 0.0;
+	double PhysicsStart   = 0.0;
+	double FramePhysicsMs = 0.0;                 // 이번 프레임 물리 씬 시간 (PostTick 에서 누적)
+	TArray<float> FrameMsSamples;
+	double PhysicsMsSum = 0.0;
+
+	FDelegateHandle PostBatchHandle;
+	FDelegateHandle PendingStartHandle;
+	FDelegateHandle PhysicsPreTickHandle;
+	FDelegateHandle PhysicsPostTickHandle;
+
+	/** 이번 단계 로봇 수까지 추가 스폰. 하나도 못 늘렸으면 false */
+	bool BeginStage();
+	void SpawnRobots(int32 Count);
+	void MeasureMemory(FHexapodProfileSample& Sample) const;
+	void EndStage();
+	void FinishProfile();
+	bool WriteResults();
+	void Cleanup();
+
+	void OnPhysicsPreTick(FPhysScene_Chaos* Scene, float DeltaSeconds);
+	void OnPhysicsPostTick(FChaosScene* Scene);
+};
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodProfileSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Hexapod.Profile.Scaling
+// 빈 게임 월드에서 로봇 1 → 2 대 두 단계를 짧게 측정하고, 모든 단계가 끝나 CSV 가 저장됐는지 확인.
+// 월드는 테스트가 직접 틱 (PIE / 맵 불필요) → 에디터, -game 어디서든 실행 가능
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace
+{
+	struct FHexapodProfileTestState
+	{
+		UWorld* World = nullptr;
+		int32   Frames = 0;
+
+		static constexpr int32 MaxFrames = 5000;   // 이 안에 안 끝나면 실패
+		static constexpr float StepSeconds = 1.f / 500.f;
+
+		bool CreateWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("HexapodProfileTest"));
+			if (!World) return false;
+
+			FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+			Context.SetCurrentWorld(World);
+
+			const FURL URL;
+			World->SetGameMode(URL);
+			World->InitializeActorsForPlay(URL);
+			World->BeginPlay();
+			return true;
+		}
+
+		void DestroyWorld()
+		{
+			if (!World) return;
+			if (UHexapodProfileSubsystem* Profile = World->GetSubsystem<UHexapodProfileSubsystem>())
+				Profile->CancelProfile();
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			World = nullptr;
+		}
+	};
+}
+
+/** 월드를 고정 스텝으로 틱하다가 측정이 끝나면 결과 확인 */
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FHexapodProfileTickCommand,
+	TSharedPtr<FHexapodProfileTestState>, State, FAutomationTestBase*, Test);
+
+bool FHexapodProfileTickCommand::Update()
+{
+	UHexapodProfileSubsystem* Profile = State->World->GetSubsystem<UHexapodProfileSubsystem>();
+	if (Profile->IsRunning() && State->Frames < FHexapodProfileTestState::MaxFrames)
+	{
+		State->World->Tick(LEVELTICK_All, FHexapodProfileTestState::StepSeconds);
+		State->Frames++;
+		return false;
+	}
+
+	if (Profile->IsRunning())
+	{
+		Test->AddError(FString::Printf(TEXT("%d 프레임 안에 측정이 끝나지 않음"), FHexapodProfileTestState::MaxFrames));
+		Profile->CancelProfile();   // 부분 결과 CSV 도 아래에서 지움
+	}
+	Test->TestEqual(TEXT("완료한 단계 수"), Profile->GetSamples().Num(), Profile->GetNumStages());
+	for (const FHexapodProfileSample& Sample : Profile->GetSamples())
+	{
+		Test->TestTrue(FString::Printf(TEXT("로봇 %d 대 프레임 시간 측정"), Sample.Robots), Sample.FrameMs > 0.0);
+		Test->TestTrue(FString::Printf(TEXT("로봇 %d 대 물리 바디 집계"), Sample.Robots), Sample.Bodies > 0);
+	}
+
+	const FString Path = Profile->GetResultPath();
+	TArray<FString> Lines;
+	Test->TestTrue(TEXT("CSV 저장"), !Path.IsEmpty() && FFileHelper::LoadFileToStringArray(Lines, *Path));
+	Test->TestEqual(TEXT("CSV 행 수 (헤더 + 단계)"), Lines.Num(), 1 + Profile->GetNumStages());
+	if (!Path.IsEmpty())
+		IFileManager::Get().Delete(*Path);
+
+	State->DestroyWorld();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHexapodProfileScalingTest, "Hexapod.Profile.Scaling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FHexapodProfileScalingTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FHexapodProfileTestState> State = MakeShared<FHexapodProfileTestState>();
+	if (!TestTrue(TEXT("테스트 월드 생성"), State->CreateWorld()))
+		return false;
+
+	UHexapodProfileSubsystem* Profile = State->World->GetSubsystem<UHexapodProfileSubsystem>();
+	if (!TestNotNull(TEXT("UHexapodProfileSubsystem"), Profile))
+	{
+		State->DestroyWorld();
+		return false;
+	}
+
+	FHexapodProfileSettings Settings;
+	Settings.MaxRobots     = 2;     // 단계: 1, 2
+	Settings.WarmupFrames  = 5;
+	Settings.MeasureFrames = 10;
+	if (!TestTrue(TEXT("StartProfile"), Profile->StartProfile(Settings)))
+	{
+		State->DestroyWorld();
+		return false;
+	}
+	TestEqual(TEXT("단계 수"), Profile->GetNumStages(), 2);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FHexapodProfileTickCommand(State, this));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1,25 +1,19 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "HexapodRobot.h"
-#include "UObject/ConstructorHelpers.h"
 #include "HexapodMovementComponent.h"
 #include "HexapodNetworkComponent.h"
+#include "HexapodSerialBridgeComponent.h"
+#include "HexapodSensorComponent.h"
+#include "HexapodSnapshotComponent.h"
+#include "HexapodBatchSubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 
 AHexapodRobot::AHexapodRobot()
 {
-	PrimaryActorTick.bCanEverTick = true;
-
-	// 메시 에셋 로드
-	static ConstructorHelpers::FObjectFinder<UStaticMesh> BodyMeshAsset(
-		TEXT("/Game/Robots/Meshes/body_frame.body_frame"));
-	static ConstructorHelpers::FObjectFinder<UStaticMesh> CoxaAsset(
-		TEXT("/Game/Robots/Meshes/coxa-996.coxa-996"));
-	static ConstructorHelpers::FObjectFinder<UStaticMesh> FemurAsset(
-		TEXT("/Game/Robots/Meshes/femur-996.femur-996"));
-	static ConstructorHelpers::FObjectFinder<UStaticMesh> TibiaAsset(
-		TEXT("/Game/Robots/Meshes/Tibia-996.Tibia-996"));
+	// 매 스텝 할 일은 컴포넌트 / 배치 서브시스템이 필요할 때만 처리
+	PrimaryActorTick.bCanEverTick = false;
 
 	// 몸통 메시 (루트)
 	BodyMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BodyMesh"));
@@ -31,26 +25,22 @@ AHexapodRobot::AHexapodRobot()
 	
 	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
 	Camera->SetupAttachment(SpringArm);
-	
-	if (BodyMeshAsset.Succeeded())
-		BodyMesh->SetStaticMesh(BodyMeshAsset.Object);
-
-
-	UStaticMesh* CoxaMesh  = CoxaAsset.Succeeded()  ? CoxaAsset.Object  : nullptr;
-	UStaticMesh* FemurMesh = FemurAsset.Succeeded() ? FemurAsset.Object : nullptr;
-	UStaticMesh* TibiaMesh = TibiaAsset.Succeeded() ? TibiaAsset.Object : nullptr;
 
+	// 메시는 OnConstruction / PostInitializeComponents 에서 (ApplyMeshAssets) — CDO 생성 시 동기 로드 없음
 	Legs.SetNum(6);
 	for (int32 i = 0; i < 6; i++)
 	{
-		InitializeLeg(i, HipOffsets[i], HipRotations[i], CoxaMesh, FemurMesh, TibiaMesh);
+		InitializeLeg(i, HipOffsets[i], HipRotations[i]);
 	}
 
 	MovementComponent = CreateDefaultSubobject<UHexapodMovementComponent>(TEXT("MovementComponent"));
 	NetworkComponent  = CreateDefaultSubobject<UHexapodNetworkComponent>(TEXT("NetworkComponent"));
+	SensorComponent   = CreateDefaultSubobject<UHexapodSensorComponent>(TEXT("SensorComponent"));
+	SnapshotComponent = CreateDefaultSubobject<UHexapodSnapshotComponent>(TEXT("SnapshotComponent"));
+	SerialBridgeComponent = CreateDefaultSubobject<UHexapodSerialBridgeComponent>(TEXT("SerialBridgeComponent"));
 }
 
-void AHexapodRobot::InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator LegRotation, UStaticMesh* CoxaMesh, UStaticMesh* FemurMesh, UStaticMesh* TibiaMesh)
+void AHexapodRobot::InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator LegRotation)
 {
 	FHexapodLeg& Leg = Legs[LegIndex];
 	FString P = FString::Printf(TEXT("Leg%d"), LegIndex);
@@ -64,7 +54,6 @@ void AHexapodRobot::InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator Le
 	Leg.HipMesh = CreateDefaultSubobject<UStaticMeshComponent>(*FString::Printf(TEXT("%s_HipMesh"), *P));
 	Leg.HipMesh->SetupAttachment(Leg.Hip);
 	Leg.HipMesh->SetSimulatePhysics(false);
-	if (CoxaMesh) Leg.HipMesh->SetStaticMesh(CoxaMesh);
 
 	Leg.HipConstraint = CreateDefaultSubobject<UPhysicsConstraintComponent>(*FString::Printf(TEXT("%s_HipConstraint"), *P));
 	Leg.HipConstraint->SetupAttachment(Leg.Hip);
@@ -79,7 +68,6 @@ void AHexapodRobot::InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator Le
 	Leg.ThighMesh = CreateDefaultSubobject<UStaticMeshComponent>(*FString::Printf(TEXT("%s_ThighMesh"), *P));
 	Leg.ThighMesh->SetupAttachment(Leg.Thigh);
 	Leg.ThighMesh->SetSimulatePhysics(false);
-	if (FemurMesh) Leg.ThighMesh->SetStaticMesh(FemurMesh);
 
 	Leg.ThighConstraint = CreateDefaultSubobject<UPhysicsConstraintComponent>(*FString::Printf(TEXT("%s_ThighConstraint"), *P));
 	Leg.ThighConstraint->SetupAttachment(Leg.Thigh);
@@ -94,7 +82,6 @@ void AHexapodRobot::InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator Le
 	Leg.CalfMesh = CreateDefaultSubobject<UStaticMeshComponent>(*FString::Printf(TEXT("%s_CalfMesh"), *P));
 	Leg.CalfMesh->SetupAttachment(Leg.Calf);
 	Leg.CalfMesh->SetSimulatePhysics(false);
-	if (TibiaMesh) Leg.CalfMesh->SetStaticMesh(TibiaMesh);
 
 	Leg.CalfConstraint = CreateDefaultSubobject<UPhysicsConstraintComponent>(*FString::Printf(TEXT("%s_CalfConstraint"), *P));
 	Leg.CalfConstraint->SetupAttachment(Leg.Calf);
@@ -107,6 +94,7 @@ void AHexapodRobot::InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator Le
 void AHexapodRobot::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
+	ApplyMeshAssets();
 
 	for (int32 i = 0; i < 6; i++)
 	{
@@ -151,9 +139,61 @@ void AHexapodRobot::OnConstruction(const FTransform& Transform)
 	}
 }
 
+void AHexapodRobot::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+	// 배치된 액터 (쿠킹/-game 로드) 는 OnConstruction 없이 여기로 옴 — 비어 있는 메시만 채우므로 중복 호출 무해
+	ApplyMeshAssets();
+}
+
+void AHexapodRobot::GetMeshAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	OutPaths.Add(BodyMeshAsset.ToSoftObjectPath());
+	OutPaths.Add(CoxaMeshAsset.ToSoftObjectPath());
+	OutPaths.Add(FemurMeshAsset.ToSoftObjectPath());
+	OutPaths.Add(TibiaMeshAsset.ToSoftObjectPath());
+}
+
+void AHexapodRobot::ApplyMeshAssets()
+{
+	// Blueprint 등에서 이미 지정한 메시는 유지
+	auto Apply = [](UStaticMeshComponent* Component, const TSoftObjectPtr<UStaticMesh>& Asset)
+	{
+		if (!Component || Component->GetStaticMesh() || Asset.IsNull()) return;
+
+		// 빠른 기동은 스폰 전에 비동기 로드가 끝나 있어 Get() 으로 충분. 그 외에는 여기서 동기 로드
+		UStaticMesh* Mesh = Asset.Get();
+		if (!Mesh) Mesh = Asset.LoadSynchronous();
+		if (Mesh) Component->SetStaticMesh(Mesh);
+	};
+
+	Apply(BodyMesh, BodyMeshAsset);
+	for (FHexapodLeg& Leg : Legs)
+	{
+		Apply(Leg.HipMesh,   CoxaMeshAsset);
+		Apply(Leg.ThighMesh, FemurMeshAsset);
+		Apply(Leg.CalfMesh,  TibiaMeshAsset);
+	}
+}
+
+void AHexapodRobot::ApplyCollisionOnly()
+{
+	// 충돌/질량은 메시 그대로, 그리기만 끔 (헤드리스 인스턴스)
+	TInlineComponentArray<UStaticMeshComponent*> Meshes(this);
+	for (UStaticMeshComponent* Mesh : Meshes)
+	{
+		Mesh->SetCastShadow(false);
+		Mesh->SetVisibility(false);
+	}
+	SpringArm->Deactivate();
+	Camera->Deactivate();
+}
+
 void AHexapodRobot::BeginPlay()
 {
 	Super::BeginPlay();
+	if (bCollisionOnly)
+		ApplyCollisionOnly();
 	SetupLegConstraints();
 	BodyMesh->SetSimulatePhysics(true);
 	//BodyMesh->SetEnableGravity(false);
@@ -176,12 +216,24 @@ void AHexapodRobot::BeginPlay()
 		StandingPose[i * 3 + 2] = 60.f;  // Calf
 	}
 	ApplyJointTargets(StandingPose);
+
+	// 월드 단위 배치 갱신 (관절 각도 / 보행 / 보상을 로봇 전체에 대해 한 번에)
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->RegisterRobot(this);
+
 	UE_LOG(LogTemp, Warning, TEXT("BodyMesh mass: %f kg"), BodyMesh->GetMass());
 	UE_LOG(LogTemp, Warning, TEXT("HipMesh mass: %f kg"), Legs[0].HipMesh->GetMass());
 	UE_LOG(LogTemp, Warning, TEXT("ThighMesh mass: %f kg"), Legs[0].ThighMesh->GetMass());
 	UE_LOG(LogTemp, Warning, TEXT("CalfMesh mass: %f kg"), Legs[0].CalfMesh->GetMass());
 }
 
+void AHexapodRobot::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->UnregisterRobot(this);
+	Super::EndPlay(EndPlayReason);
+}
+
 void AHexapodRobot::SetupLegConstraints()
 {
 	for (int32 i = 0; i < 6; i++)
@@ -238,10 +290,19 @@ void AHexapodRobot::SetupLegConstraints()
 	}
 }
 
-void AHexapodRobot::Tick(float DeltaTime)
+// 컨트롤러 입력(MoveForward/MoveRight)이 배치 보행 계산보다 먼저 처리되도록
+void AHexapodRobot::PossessedBy(AController* NewController)
 {
-	Super::Tick(DeltaTime);
-	
+	Super::PossessedBy(NewController);
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->AddInputSource(NewController);
+}
+
+void AHexapodRobot::UnPossessed()
+{
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->RemoveInputSource(Controller);
+	Super::UnPossessed();
 }
 
 void AHexapodRobot::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -260,13 +321,22 @@ void AHexapodRobot::ApplyJointTargets(const TArray<float>& Targets)
 {
 	if (Targets.Num() != 18) return;
 
+	SetConstraintTargets(Targets.GetData());
+
+	// 같은 목표값을 실제 로봇으로 (시리얼 브리지 활성 시)
+	if (SerialBridgeComponent)
+		SerialBridgeComponent->MirrorJointTargets(Targets);
+}
+
+void AHexapodRobot::SetConstraintTargets(const float* Targets)
+{
+	FMemory::Memcpy(ConstraintTargets, Targets, sizeof(ConstraintTargets));
 	for (int32 i = 0; i < 6; i++)
 	{
 		Legs[i].HipConstraint->SetAngularOrientationTarget(FRotator(   0.f, Targets[i * 3 + 0], 0.f));
 		Legs[i].ThighConstraint->SetAngularOrientationTarget(FRotator( 0.f, Targets[i * 3 + 1], 0.f));
 		Legs[i].CalfConstraint->SetAngularOrientationTarget(FRotator(  0.f, Targets[i * 3 + 2], 0.f));
 	}
-
 }
 
 // RL Observation: 현재 관절 각도 18개 반환
@@ -274,6 +344,19 @@ TArray<float> AHexapodRobot::GetJointAngles() const
 {
 	TArray<float> Angles;
 	Angles.SetNum(18);
+	GetJointAngles(Angles.GetData());
+	return Angles;
+}
+
+void AHexapodRobot::GetJointAngles(float* OutAngles) const
+{
+	// 마지막 물리 스텝 이후 배치 서브시스템이 계산해 둔 값이 있으면 그대로 사용
+	if (BatchIndex != INDEX_NONE)
+	{
+		UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>();
+		if (Batch && Batch->CopyJointAngles(BatchIndex, OutAngles))
+			return;
+	}
 
 	for (int32 i = 0; i < 6; i++)
 	{
@@ -281,22 +364,58 @@ TArray<float> AHexapodRobot::GetJointAngles() const
 		FQuat BodyW = BodyMesh->GetComponentQuat();
 		FQuat HipW = Legs[i].HipMesh->GetComponentQuat();
 		FQuat HipRel = BodyW.Inverse() * HipW;
-		Angles[i * 3 + 0] = HipRel.Rotator().Yaw;
+		OutAngles[i * 3 + 0] = HipRel.Rotator().Yaw;
 
 		// Thigh: ThighMesh와 HipMesh 사이 상대 회전
 		FQuat ThighW = Legs[i].ThighMesh->GetComponentQuat();
 		FQuat ThighRel = HipW.Inverse() * ThighW;
-		Angles[i * 3 + 1] = ThighRel.Rotator().Yaw;
+		OutAngles[i * 3 + 1] = ThighRel.Rotator().Yaw;
 
 		// Calf: CalfMesh와 ThighMesh 사이 상대 회전
 		FQuat CalfW = Legs[i].CalfMesh->GetComponentQuat();
 		FQuat CalfRel = ThighW.Inverse() * CalfW;
-		Angles[i * 3 + 2] = CalfRel.Rotator().Yaw;
+		OutAngles[i * 3 + 2] = CalfRel.Rotator().Yaw;
 	}
+}
 
-	return Angles;
+void AHexapodRobot::GetObservation(float* OutObs) const
+{
+	GetJointAngles(OutObs);
+
+	const FVector  Pos = GetActorLocation();
+	const FRotator Rot = GetActorRotation();
+	OutObs[18] = Pos.X;    OutObs[19] = Pos.Y;     OutObs[20] = Pos.Z;
+	OutObs[21] = Rot.Roll; OutObs[22] = Rot.Pitch; OutObs[23] = Rot.Yaw;
 }
 
+void AHexapodRobot::GetFootObservation(float* OutFields) const
+{
+	UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>();
+	if (BatchIndex != INDEX_NONE && Batch && Batch->CopyFootObservation(BatchIndex, OutFields))
+		return;
+
+	// 배치 미등록: 현재 관절 각도로 직접 계산
+	float Angles[18];
+	GetFootJointAngles(Angles);
+	const FVector Down = BodyMesh->GetComponentQuat().UnrotateVector(FVector(0.0, 0.0, -1.0));
+	const float DownArr[3] = { (float)Down.X, (float)Down.Y, (float)Down.Z };
+	const HexapodKinematics::FLegGeometry Geometry = Batch ? Batch->LegGeometry : HexapodKinematics::FLegGeometry::Default();
+	HexapodKinematics::ComputeFootObservation(Geometry, Angles, DownArr, OutFields);
+}
+
+void AHexapodRobot::GetFootJointAngles(float* OutAngles) const
+{
+	const FQuat BodyW = BodyMesh->GetComponentQuat();
+	for (int32 i = 0; i < 6; i++)
+	{
+		const FQuat HipW   = Legs[i].HipMesh->GetComponentQuat();
+		const FQuat ThighW = Legs[i].ThighMesh->GetComponentQuat();
+		const FQuat CalfW  = Legs[i].CalfMesh->GetComponentQuat();
+		OutAngles[i * 3 + 0] = (BodyW.Inverse() * HipW).Rotator().Yaw;
+		OutAngles[i * 3 + 1] = (HipW.Inverse() * ThighW).Rotator().Pitch;   // 피치 관절: Yaw 는 ≈0
+		OutAngles[i * 3 + 2] = (ThighW.Inverse() * CalfW).Rotator().Yaw;
+	}
+}
 
 void AHexapodRobot::MoveForward(float Value)
 {
@@ -51,22 +51,56 @@ class SIM_TO_REAL_HEXAPOD_API AHexapodRobot : public APawn
 
 public:
 	AHexapodRobot();
-	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	// RL Action: 18개 목표 각도 입력 (6다리 × 3관절)
 	void ApplyJointTargets(const TArray<float>& Targets);
 
+	// 관절 드라이브 목표만 설정 (보행/배치 계산 결과 반영용, 시리얼 미러링 없음)
+	void SetConstraintTargets(const float* Targets);
+	// 마지막으로 설정한 관절 드라이브 목표 18개
+	const float* GetConstraintTargets() const { return ConstraintTargets; }
+
 	// RL Observation: 18개 관절 현재 각도 반환
 	TArray<float> GetJointAngles() const;
+	// 할당 없는 버전: OutAngles 는 18개 이상
+	void GetJointAngles(float* OutAngles) const;
+
+	// OBS 필드 순서 (관절 18 + 위치 3 + roll pitch yaw). OutObs 는 24개 이상
+	void GetObservation(float* OutObs) const;
+
+	// 발끝 FK 관측 (HexapodKinematics::FootFields 개: 발끝 xyz × 6 + 접지 마스크 + 안정 여유 + 지지 넓이)
+	void GetFootObservation(float* OutFields) const;
+	// FK 입력 각도 18개 (Hip Yaw / Thigh Pitch / Calf Yaw, HexapodKinematics.h "입력 각도")
+	void GetFootJointAngles(float* OutAngles) const;
 
 	const TArray<FHexapodLeg>& GetLegs() const { return Legs; }
+	UStaticMeshComponent* GetBodyMesh() const { return BodyMesh; }
+
+	// UHexapodBatchSubsystem 내 SoA 인덱스 (미등록 시 INDEX_NONE)
+	int32 GetBatchIndex() const { return BatchIndex; }
+
+	// 메시 에셋 경로 4종 (빠른 기동에서 비동기 로드 대상)
+	void GetMeshAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
+	// 렌더링 없이 물리/충돌만 (메시 숨김, 그림자/카메라 끔). Deferred 스폰이면 FinishSpawning 전에 설정
+	UPROPERTY(EditAnywhere, Category = "Robot|Boot")
+	bool bCollisionOnly = false;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void PossessedBy(AController* NewController) override;
+	virtual void UnPossessed() override;
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void PostInitializeComponents() override;
 
 private:
+	friend class UHexapodBatchSubsystem;
+	int32 BatchIndex = INDEX_NONE;
+
+	float ConstraintTargets[18] = {};
+
 	void MoveForward(float Value);
 	void MoveRight(float Value);
 
@@ -85,8 +119,23 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "Robot", meta = (AllowPrivateAccess = "true"))
 	TArray<FHexapodLeg> Legs;
 
+	// 메시 에셋 — 생성자 동기 로드(FObjectFinder) 대신 소프트 참조.
+	// OnConstruction / PostInitializeComponents 에서 비어 있는 메시 컴포넌트에만 적용 (이미 로드돼 있으면 그대로, 아니면 동기 로드)
+	// 레벨에 배치된 액터는 -game 에서 OnConstruction 을 다시 타지 않으므로 PostInitializeComponents 가 담당
+	UPROPERTY(EditDefaultsOnly, Category = "Robot|Mesh")
+	TSoftObjectPtr<UStaticMesh> BodyMeshAsset { FSoftObjectPath(TEXT("/Game/Robots/Meshes/body_frame.body_frame")) };
+	UPROPERTY(EditDefaultsOnly, Category = "Robot|Mesh")
+	TSoftObjectPtr<UStaticMesh> CoxaMeshAsset { FSoftObjectPath(TEXT("/Game/Robots/Meshes/coxa-996.coxa-996")) };
+	UPROPERTY(EditDefaultsOnly, Category = "Robot|Mesh")
+	TSoftObjectPtr<UStaticMesh> FemurMeshAsset { FSoftObjectPath(TEXT("/Game/Robots/Meshes/femur-996.femur-996")) };
+	UPROPERTY(EditDefaultsOnly, Category = "Robot|Mesh")
+	TSoftObjectPtr<UStaticMesh> TibiaMeshAsset { FSoftObjectPath(TEXT("/Game/Robots/Meshes/Tibia-996.Tibia-996")) };
+
+	void ApplyMeshAssets();
+	void ApplyCollisionOnly();
+
 	// 생성자에서 다리 컴포넌트 초기화
-	void InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator LegRotation, UStaticMesh* CoxaMesh, UStaticMesh* FemurMesh, UStaticMesh* TibiaMesh);
+	void InitializeLeg(int32 LegIndex, FVector LegOffset, FRotator LegRotation);
 
 	// BeginPlay에서 물리 관절 연결 및 설정
 	void SetupLegConstraints();
@@ -154,10 +203,29 @@ private:
 	FRotator CalfConstraintRotation = FRotator(0.f, 0.f, 90.f);
 
 
+	/*
+	 * 틱 스케줄 (로봇 자체는 틱 없음)
+	 *  TG_PrePhysics  : NetworkComponent (수신 패킷이 있을 때만) → 배치 보행 계산 (보행 중인 로봇만)
+	 *  ── 물리 ──
+	 *  TG_PostPhysics : 배치 관절 각도/보상 → SensorComponent (히스토리 소비자가 있을 때만)
+	 *                   → NetworkComponent 응답 (이번 스텝 결과로 OBS 전송)
+	 */
 	UPROPERTY(VisibleAnywhere, Category = "Movement")
 	class UHexapodMovementComponent* MovementComponent;
 
 	UPROPERTY(VisibleAnywhere, Category = "Network")
 	class UHexapodNetworkComponent* NetworkComponent;
 
+	// 물리 스텝마다 관측값 기록 (지연/노이즈 히스토리)
+	UPROPERTY(VisibleAnywhere, Category = "Sensor")
+	class UHexapodSensorComponent* SensorComponent;
+
+	// 물리 상태 저장/복원 슬롯 (분기 롤아웃, MPC)
+	UPROPERTY(VisibleAnywhere, Category = "Snapshot")
+	class UHexapodSnapshotComponent* SnapshotComponent;
+
+	// ApplyJointTargets → 실제 로봇(Pico) 미러링. DevicePath 비우면 비활성
+	UPROPERTY(VisibleAnywhere, Category = "Network")
+	class UHexapodSerialBridgeComponent* SerialBridgeComponent;
+
 };
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodSensorComponent.h"
+#include "HexapodRobot.h"
+
+UHexapodSensorComponent::UHexapodSensorComponent()
+{
+	// 물리 결과가 확정된 뒤 기록 → 관측값이 한 프레임 밀리지 않음
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UHexapodSensorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	HexapodRobot = Cast<AHexapodRobot>(GetOwner());
+	if (!HexapodRobot)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HexapodSensorComponent: Owner가 AHexapodRobot이 아닙니다."));
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	// 지연 + 스택이 들어갈 수 있도록 용량 확보 (이후 재할당 없음)
+	History.Init(FMath::Max(HistoryCapacity, SensorDelaySteps + 1));
+	NoiseStream.Initialize(NoiseSeed);
+	SetComponentTickEnabled(bAlwaysRecord);
+}
+
+void UHexapodSensorComponent::SetRecording(bool bRecord)
+{
+	if (!HexapodRobot) return;
+	SetComponentTickEnabled(bRecord || bAlwaysRecord);
+}
+
+// Box-Muller
+float UHexapodSensorComponent::Gaussian(float StdDev)
+{
+	if (StdDev <= 0.f) return 0.f;
+	const float U1 = FMath::Max(NoiseStream.GetFraction(), KINDA_SMALL_NUMBER);
+	const float U2 = NoiseStream.GetFraction();
+	return StdDev * FMath::Sqrt(-2.f * FMath::Loge(U1)) * FMath::Cos(2.f * PI * U2);
+}
+
+// 물리 스텝 1회 = 스냅샷 1개
+void UHexapodSensorComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+                                             FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (!HexapodRobot) return;
+
+	float* Noise  = nullptr;
+	float* Values = History.BeginWrite(Noise);
+
+	HexapodRobot->GetObservation(Values);
+
+	for (int32 i = 0; i < 18; i++)  Noise[i] = Gaussian(JointNoiseStdDeg);
+	for (int32 i = 18; i < 21; i++) Noise[i] = Gaussian(PositionNoiseStdCm);
+	for (int32 i = 21; i < 24; i++) Noise[i] = Gaussian(AttitudeNoiseStdDeg);
+
+	History.Commit(GetWorld()->GetTimeSeconds());
+}
@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HexapodSensorComponent.generated.h"
+
+/** 관측 스냅샷 하나의 필드 수 (OBS 와 같은 순서: 관절 18 + 위치 3 + roll pitch yaw) */
+constexpr int32 HexapodObsFields = 24;
+
+/**
+ * 지연/노이즈 관측값 뷰 — 링 버퍼 슬롯을 가리킬 뿐 복사하지 않음.
+ * 값 = Values[i] + Noise[i]
+ */
+struct FHexapodObsView
+{
+	const float* Values = nullptr;
+	const float* Noise  = nullptr;
+	double       Time   = 0.0;
+
+	float operator[](int32 Index) const { return Values[Index] + Noise[Index]; }
+};
+
+/**
+ * 고정 용량 관측 링 버퍼.
+ * Init 에서 한 번만 할당하고, 이후 Push 는 가장 오래된 슬롯을 덮어씀.
+ * 노이즈는 기록 시점에 평행 배열에 생성해 두므로 같은 스텝을 여러 번 읽어도 값이 같음.
+ */
+class FHexapodObservationRing
+{
+public:
+	void Init(int32 InCapacity)
+	{
+		Capacity = FMath::Max(InCapacity, 1);
+		Values.SetNumZeroed(Capacity * HexapodObsFields);
+		Noise.SetNumZeroed(Capacity * HexapodObsFields);
+		Times.SetNumZeroed(Capacity);
+		Head  = 0;
+		Count = 0;
+	}
+
+	/** 다음 슬롯 포인터 (값, 노이즈) — 호출자가 채운 뒤 Commit */
+	float* BeginWrite(float*& OutNoise)
+	{
+		OutNoise = &Noise[Head * HexapodObsFields];
+		return &Values[Head * HexapodObsFields];
+	}
+
+	void Commit(double Time)
+	{
+		Times[Head] = Time;
+		Head  = (Head + 1) % Capacity;
+		Count = FMath::Min(Count + 1, Capacity);
+	}
+
+	/** Age 스텝 전 스냅샷 (0 = 최신). 아직 기록되지 않았으면 가장 오래된 것으로 대체 */
+	FHexapodObsView Get(int32 Age) const
+	{
+		FHexapodObsView View;
+		if (Count == 0) return View;
+
+		const int32 Clamped = FMath::Clamp(Age, 0, Count - 1);
+		const int32 Slot    = (Head - 1 - Clamped + Capacity) % Capacity;
+		View.Values = &Values[Slot * HexapodObsFields];
+		View.Noise  = &Noise[Slot * HexapodObsFields];
+		View.Time   = Times[Slot];
+		return View;
+	}
+
+	int32 Num() const         { return Count; }
+	int32 GetCapacity() const { return Capacity; }
+	SIZE_T GetAllocatedSize() const
+	{
+		return Values.GetAllocatedSize() + Noise.GetAllocatedSize() + Times.GetAllocatedSize();
+	}
+
+private:
+	TArray<float>  Values;
+	TArray<float>  Noise;
+	TArray<double> Times;
+	int32 Capacity = 1;
+	int32 Head  = 0;
+	int32 Count = 0;
+};
+
+/**
+ * UHexapodSensorComponent
+ *
+ * 물리 스텝이 끝난 직후(TG_PostPhysics) 관절 각도 + 몸체 위치/자세를 링 버퍼에 기록.
+ * 정책은 실제 로봇처럼 SensorDelaySteps 만큼 늦고 노이즈가 섞인 최근 K 프레임을 봄.
+ *
+ *  GetStacked(k) = k 번째 과거 프레임 (0 = 지연 적용된 최신)
+ *               = 링 버퍼 Age (SensorDelaySteps + k) 슬롯
+ *
+ * 기록은 히스토리를 읽는 쪽이 있을 때만 (bAlwaysRecord 또는 SetRecording) — 아무도 안 보면 틱 꺼짐.
+ * 기록 주기는 PrimaryComponentTick.TickInterval (0 = 물리 스텝마다).
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SIM_TO_REAL_HEXAPOD_API UHexapodSensorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHexapodSensorComponent();
+
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+	                           FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** 지연 적용 후 k 번째 과거 프레임 뷰 (복사 없음) */
+	FHexapodObsView GetStacked(int32 K) const { return History.Get(SensorDelaySteps + K); }
+
+	/** 요청 가능한 최대 스택 길이 (용량 - 지연) */
+	int32 GetMaxStack() const { return FMath::Max(History.GetCapacity() - SensorDelaySteps, 1); }
+
+	int32 GetNumRecorded() const { return History.Num(); }
+
+	/** 히스토리 소비자(HISTORY K 클라이언트 등)가 생기거나 없어질 때 호출 */
+	void SetRecording(bool bRecord);
+
+	/** 소비자 유무와 관계없이 항상 기록 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor")
+	bool bAlwaysRecord = false;
+
+	/** 링 버퍼 용량 (스텝). BeginPlay 에서 한 번 할당 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor", meta = (ClampMin = "1", ClampMax = "1024"))
+	int32 HistoryCapacity = 64;
+
+	/** 센서 지연 (물리 스텝 수) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor", meta = (ClampMin = "0"))
+	int32 SensorDelaySteps = 0;
+
+	/** 관절 각도 가우시안 노이즈 표준편차 (도) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor|Noise", meta = (ClampMin = "0"))
+	float JointNoiseStdDeg = 0.f;
+
+	/** 위치 노이즈 표준편차 (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor|Noise", meta = (ClampMin = "0"))
+	float PositionNoiseStdCm = 0.f;
+
+	/** 자세(roll pitch yaw) 노이즈 표준편차 (도) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor|Noise", meta = (ClampMin = "0"))
+	float AttitudeNoiseStdDeg = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor|Noise")
+	int32 NoiseSeed = 0;
+
+private:
+	class AHexapodRobot* HexapodRobot = nullptr;
+
+	FHexapodObservationRing History;
+	FRandomStream           NoiseStream;
+
+	float Gaussian(float StdDev);
+};
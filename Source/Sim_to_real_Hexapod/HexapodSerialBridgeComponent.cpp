@@ -0,0 +1,318 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodSerialBridgeComponent.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+
+#if PLATFORM_WINDOWS
+	#include "Windows/AllowWindowsPlatformTypes.h"
+	#include <windows.h>
+	#include "Windows/HideWindowsPlatformTypes.h"
+#else
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <termios.h>
+	#include <unistd.h>
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// FHexapodSerialWriter — 고정 주기로 최신 펄스 프레임만 시리얼에 쓰는 스레드
+// ─────────────────────────────────────────────────────────────────────────────
+
+class FHexapodSerialWriter : public FRunnable
+{
+public:
+	FHexapodSerialWriter(const FString& InDevicePath, int32 InBaudRate, float InRateHz)
+		: DevicePath(InDevicePath), BaudRate(InBaudRate), PeriodSec(1.0 / FMath::Max(InRateHz, 1.f))
+	{
+	}
+
+	virtual ~FHexapodSerialWriter() override
+	{
+		ClosePort();
+	}
+
+	bool OpenPort();
+
+	/** 게임 스레드 → 최신 프레임 교체 (이전 미전송 프레임은 버려짐) */
+	void Submit(const uint16 (&Pulses)[18])
+	{
+		FScopeLock Guard(&FrameLock);
+		FMemory::Memcpy(Latest, Pulses, sizeof(Latest));
+		LatestVersion++;
+	}
+
+	virtual uint32 Run() override;
+	virtual void Stop() override { bStopping = true; }
+
+	// 통계 (EndPlay 로그용)
+	TAtomic<uint32> FramesSubmitted { 0 };
+	TAtomic<uint32> FramesWritten   { 0 };
+	TAtomic<uint32> ErrorReplies    { 0 };
+
+private:
+	FString DevicePath;
+	int32   BaudRate;
+	double  PeriodSec;
+	TAtomic<bool> bStopping { false };
+
+	FCriticalSection FrameLock;
+	uint16 Latest[18] = {};
+	uint32 LatestVersion = 0;
+
+	// Pico 응답("OK"/"ERR") 줄 조립용
+	char   ReplyLine[64] = {};
+	int32  ReplyLen = 0;
+
+#if PLATFORM_WINDOWS
+	HANDLE Port = INVALID_HANDLE_VALUE;
+#else
+	int Port = -1;
+#endif
+
+	bool WriteAll(const char* Data, int32 Len);
+	void DrainReplies();
+	void ClosePort();
+};
+
+bool FHexapodSerialWriter::OpenPort()
+{
+#if PLATFORM_WINDOWS
+	// COM10 이상도 열리도록 \\.\ 접두사 사용
+	const FString Path = DevicePath.StartsWith(TEXT("\\\\.\\")) ? DevicePath : TEXT("\\\\.\\") + DevicePath;
+	Port = CreateFileW(*Path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+	if (Port == INVALID_HANDLE_VALUE) return false;
+
+	DCB Dcb = {};
+	Dcb.DCBlength = sizeof(Dcb);
+	GetCommState(Port, &Dcb);
+	Dcb.BaudRate = BaudRate;
+	Dcb.ByteSize = 8;
+	Dcb.Parity   = NOPARITY;
+	Dcb.StopBits = ONESTOPBIT;
+	Dcb.fDtrControl = DTR_CONTROL_ENABLE;   // Pico USB CDC 는 DTR 이 있어야 송신
+	SetCommState(Port, &Dcb);
+
+	// 읽기는 즉시 반환 (논블로킹 폴링)
+	COMMTIMEOUTS Timeouts = {};
+	Timeouts.ReadIntervalTimeout = MAXDWORD;
+	SetCommTimeouts(Port, &Timeouts);
+	return true;
+#else
+	Port = open(TCHAR_TO_UTF8(*DevicePath), O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (Port < 0) return false;
+
+	termios Tio = {};
+	if (tcgetattr(Port, &Tio) == 0)
+	{
+		cfmakeraw(&Tio);
+		const speed_t Speed = BaudRate >= 921600 ? B921600 : BaudRate >= 460800 ? B460800 :
+		                      BaudRate >= 230400 ? B230400 : BaudRate >= 115200 ? B115200 :
+		                      BaudRate >= 57600  ? B57600  : B9600;
+		cfsetispeed(&Tio, Speed);
+		cfsetospeed(&Tio, Speed);
+		Tio.c_cflag |= CLOCAL | CREAD;
+		tcsetattr(Port, TCSANOW, &Tio);   // pty 는 속도 설정을 무시하므로 실패해도 진행
+	}
+	return true;
+#endif
+}
+
+void FHexapodSerialWriter::ClosePort()
+{
+#if PLATFORM_WINDOWS
+	if (Port != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(Port);
+		Port = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (Port >= 0)
+	{
+		close(Port);
+		Port = -1;
+	}
+#endif
+}
+
+bool FHexapodSerialWriter::WriteAll(const char* Data, int32 Len)
+{
+	int32 Offset = 0;
+	while (Offset < Len && !bStopping)
+	{
+#if PLATFORM_WINDOWS
+		DWORD Written = 0;
+		if (!WriteFile(Port, Data + Offset, Len - Offset, &Written, nullptr)) return false;
+		Offset += static_cast<int32>(Written);
+#else
+		const ssize_t Written = write(Port, Data + Offset, Len - Offset);
+		if (Written < 0)
+		{
+			if (errno != EAGAIN) return false;
+			FPlatformProcess::SleepNoStats(0.0005f);
+			continue;
+		}
+		Offset += static_cast<int32>(Written);
+#endif
+	}
+	return Offset == Len;
+}
+
+// Pico 는 명령마다 "OK"/"ERR" 을 돌려줌 — 읽지 않으면 USB 버퍼가 차서 Pico 쪽 쓰기가 멈춤
+void FHexapodSerialWriter::DrainReplies()
+{
+	char Buffer[256];
+	for (;;)
+	{
+#if PLATFORM_WINDOWS
+		DWORD Read = 0;
+		if (!ReadFile(Port, Buffer, sizeof(Buffer), &Read, nullptr) || Read == 0) return;
+		const int32 NumRead = static_cast<int32>(Read);
+#else
+		const ssize_t Read = read(Port, Buffer, sizeof(Buffer));
+		if (Read <= 0) return;
+		const int32 NumRead = static_cast<int32>(Read);
+#endif
+		for (int32 i = 0; i < NumRead; i++)
+		{
+			if (Buffer[i] == '\n')
+			{
+				ReplyLine[ReplyLen] = '\0';
+				if (FCStringAnsi::Strncmp(ReplyLine, "ERR", 3) == 0) ErrorReplies++;
+				ReplyLen = 0;
+			}
+			else if (ReplyLen < static_cast<int32>(sizeof(ReplyLine)) - 1)
+			{
+				ReplyLine[ReplyLen++] = Buffer[i];
+			}
+		}
+	}
+}
+
+uint32 FHexapodSerialWriter::Run()
+{
+	uint16 Pulses[18];
+	uint32 SentVersion = 0;
+	char   Line[160];
+
+	double NextTime = FPlatformTime::Seconds();
+	while (!bStopping)
+	{
+		uint32 Version;
+		{
+			FScopeLock Guard(&FrameLock);
+			Version = LatestVersion;
+			FMemory::Memcpy(Pulses, Latest, sizeof(Pulses));
+		}
+
+		if (Version != SentVersion)
+		{
+			int32 Len = FCStringAnsi::Sprintf(Line, "PULSES");
+			for (int32 i = 0; i < 18; i++)
+				Len += FCStringAnsi::Sprintf(Line + Len, " %u", static_cast<uint32>(Pulses[i]));
+			Line[Len++] = '\n';
+
+			if (WriteAll(Line, Len))
+			{
+				SentVersion = Version;
+				FramesWritten++;
+			}
+		}
+		DrainReplies();
+
+		// 고정 주기 유지: 밀린 경우 따라잡지 않고 현재 시각 기준으로 재정렬
+		NextTime += PeriodSec;
+		const double Now = FPlatformTime::Seconds();
+		if (NextTime < Now)
+			NextTime = Now;
+		else
+			FPlatformProcess::SleepNoStats(static_cast<float>(NextTime - Now));
+	}
+	return 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// UHexapodSerialBridgeComponent
+// ─────────────────────────────────────────────────────────────────────────────
+
+UHexapodSerialBridgeComponent::UHexapodSerialBridgeComponent()
+{
+	// 쓰기는 별도 스레드가 담당 → 컴포넌트 틱 불필요
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UHexapodSerialBridgeComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (DevicePath.IsEmpty()) return;
+	if (Calibration.Num() != 18 || StandingDeg.Num() != 3 || UsPerDeg.Num() != 3)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HexapodSerialBridge: 캘리브레이션 배열 크기가 잘못되었습니다 (18 / 3 / 3)."));
+		return;
+	}
+
+	Writer = new FHexapodSerialWriter(DevicePath, BaudRate, SendRateHz);
+	if (!Writer->OpenPort())
+	{
+		UE_LOG(LogTemp, Error, TEXT("HexapodSerialBridge: %s 열기 실패"), *DevicePath);
+		delete Writer;
+		Writer = nullptr;
+		return;
+	}
+
+	WriterThread = FRunnableThread::Create(Writer, TEXT("HexapodSerialWriter"), 0, TPri_AboveNormal);
+	UE_LOG(LogTemp, Log, TEXT("HexapodSerialBridge: %s @ %d baud, %.0f Hz"), *DevicePath, BaudRate, SendRateHz);
+}
+
+void UHexapodSerialBridgeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopWriter();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UHexapodSerialBridgeComponent::StopWriter()
+{
+	if (!Writer) return;
+
+	if (WriterThread)
+	{
+		WriterThread->Kill(true);   // Stop() 호출 후 종료 대기
+		delete WriterThread;
+		WriterThread = nullptr;
+	}
+
+	const uint32 Submitted = Writer->FramesSubmitted;
+	const uint32 Written   = Writer->FramesWritten;
+	UE_LOG(LogTemp, Log, TEXT("HexapodSerialBridge: 제출 %u / 전송 %u (병합 %u), ERR 응답 %u"),
+	       Submitted, Written, Submitted > Written ? Submitted - Written : 0u, static_cast<uint32>(Writer->ErrorReplies));
+
+	delete Writer;
+	Writer = nullptr;
+}
+
+int32 UHexapodSerialBridgeComponent::AngleToPulse(int32 JointIndex, float AngleDeg) const
+{
+	const int32 Joint = JointIndex % 3;
+	const FHexapodServoCalibration& Cal = Calibration[JointIndex];
+
+	float Offset = (AngleDeg - StandingDeg[Joint]) * UsPerDeg[Joint];
+	if (Cal.bInverted) Offset = -Offset;
+
+	// Python int() 와 같이 0 방향 버림
+	return FMath::Clamp(static_cast<int32>(Cal.CenterPulse + Offset), MinPulse, MaxPulse);
+}
+
+void UHexapodSerialBridgeComponent::MirrorJointTargets(const TArray<float>& Targets)
+{
+	if (!Writer || Targets.Num() != 18) return;
+
+	uint16 Pulses[18];
+	for (int32 i = 0; i < 18; i++)
+		Pulses[i] = static_cast<uint16>(AngleToPulse(i, Targets[i]));
+
+	Writer->Submit(Pulses);
+	Writer->FramesSubmitted++;
+}
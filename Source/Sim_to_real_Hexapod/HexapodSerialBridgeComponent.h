@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HexapodSerialBridgeComponent.generated.h"
+
+// 전방 선언 — 시리얼 쓰기 스레드는 cpp 내부 구현
+class FHexapodSerialWriter;
+class FRunnableThread;
+
+/** 서보 1개 캘리브레이션 (robot_pico.py calibration 과 동일 의미) */
+USTRUCT(BlueprintType)
+struct FHexapodServoCalibration
+{
+	GENERATED_BODY()
+
+	FHexapodServoCalibration() = default;
+	FHexapodServoCalibration(int32 InCenterPulse, bool bInInverted)
+		: CenterPulse(InCenterPulse), bInverted(bInInverted) {}
+
+	// 서있는 자세일 때 펄스폭 (μs)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 CenterPulse = 1500;
+
+	// 서보 장착 방향이 반대면 true
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bInverted = false;
+};
+
+/**
+ * UHexapodSerialBridgeComponent
+ *
+ * ApplyJointTargets 로 들어온 18개 목표 각도를 실제 로봇(Pico)으로 그대로 미러링.
+ * 각도 → 펄스 변환(CALIBRATION / US_PER_DEG)은 여기서 한 번만 수행하고,
+ * 쓰기 스레드가 고정 주기(SendRateHz)로 가장 최신 프레임만 전송.
+ * → 시뮬레이션과 실제 로봇의 타이밍 기준이 UE5 하나로 통일됨.
+ *
+ * ── 송신 프로토콜 (UE5 → Pico) ────────────────────────────────────────────
+ *  "PULSES p0 p1 ... p17\n" : UE5 다리 순서(Leg0 Hip ~ Leg5 Calf)의 펄스폭(μs)
+ *
+ * DevicePath 가 비어 있으면 비활성 (스레드 생성 안 함).
+ * 실제 하드웨어 대신 Scripts/serial_standin.py 가 만든 가상 터미널(pty) 경로를 넣어 시험 가능.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SIM_TO_REAL_HEXAPOD_API UHexapodSerialBridgeComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHexapodSerialBridgeComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** ApplyJointTargets 에서 호출 — 펄스로 변환해 쓰기 스레드에 최신 프레임으로 넘김 */
+	void MirrorJointTargets(const TArray<float>& Targets);
+
+	bool IsBridgeActive() const { return Writer != nullptr; }
+
+	/** 시리얼 장치 ("COM3", "/dev/ttyACM0", pty 경로). 비우면 비활성 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial")
+	FString DevicePath;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial")
+	int32 BaudRate = 115200;
+
+	/** 쓰기 주기 (Hz). 그 사이에 들어온 프레임은 마지막 것만 전송 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial", meta = (ClampMin = "1", ClampMax = "1000"))
+	float SendRateHz = 50.f;
+
+	// ----------------------------------------------- 각도 → 펄스 변환 (hexapod_interface.py 와 동기화)
+
+	// 서있는 자세 기준 각도 [Hip, Thigh, Calf]
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial|Calibration")
+	TArray<float> StandingDeg = { 0.f, 0.f, 60.f };
+
+	// 각도 → 펄스 변환 비율 (μs/°) [Hip, Thigh, Calf]
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial|Calibration")
+	TArray<float> UsPerDeg = { 6.8f, 5.f, 5.f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial|Calibration")
+	int32 MinPulse = 600;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial|Calibration")
+	int32 MaxPulse = 2200;
+
+	/*
+	 * UE5 관절 순서 (Leg i * 3 + Joint) 별 서보 캘리브레이션
+	 *  UE5 Leg:  0(뒤R)  1(중R)  2(앞R)  3(뒤L)  4(중L)  5(앞L)
+	 *  실제 로봇: R3      R2      R1      L3      L2      L1
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serial|Calibration")
+	TArray<FHexapodServoCalibration> Calibration = {
+		{ 1475, false }, { 1607, false }, { 1694, false },   // Leg0 = R3 (R31 R32 R33)
+		{ 1391, false }, { 1388, false }, { 1493, false },   // Leg1 = R2 (R21 R22 R23)
+		{ 1491, false }, { 1524, false }, { 1494, false },   // Leg2 = R1 (R11 R12 R13)
+		{ 1625, false }, { 1527, true  }, { 1437, true  },   // Leg3 = L3 (L31 L32 L33)
+		{ 1464, false }, { 1489, true  }, { 1383, true  },   // Leg4 = L2 (L21 L22 L23)
+		{ 1415, false }, { 1497, true  }, { 1511, true  },   // Leg5 = L1 (L11 L12 L13)
+	};
+
+private:
+	FHexapodSerialWriter* Writer = nullptr;
+	FRunnableThread*      WriterThread = nullptr;
+
+	/** hexapod_interface.py angle_to_pulse() 와 같은 변환 */
+	int32 AngleToPulse(int32 JointIndex, float AngleDeg) const;
+
+	void StopWriter();
+};
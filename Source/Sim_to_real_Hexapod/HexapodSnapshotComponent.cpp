@@ -0,0 +1,245 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HexapodSnapshotComponent.h"
+#include "HexapodRobot.h"
+#include "HexapodMovementComponent.h"
+#include "HexapodDatasetSubsystem.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+UHexapodSnapshotComponent::UHexapodSnapshotComponent()
+{
+	// 결정성 검사 중에만 PrePhysics 틱 (행동 적용 → 물리)
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UHexapodSnapshotComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	HexapodRobot = Cast<AHexapodRobot>(GetOwner());
+	if (!HexapodRobot)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HexapodSnapshotComponent: Owner가 AHexapodRobot이 아닙니다."));
+		return;
+	}
+	MovementComp = HexapodRobot->FindComponentByClass<UHexapodMovementComponent>();
+
+	const TArray<FHexapodLeg>& Legs = HexapodRobot->GetLegs();
+	Bodies[0] = HexapodRobot->GetBodyMesh();
+	for (int32 Leg = 0; Leg < 6; Leg++)
+	{
+		Bodies[1 + Leg * 3 + 0] = Legs[Leg].HipMesh;
+		Bodies[1 + Leg * 3 + 1] = Legs[Leg].ThighMesh;
+		Bodies[1 + Leg * 3 + 2] = Legs[Leg].CalfMesh;
+	}
+
+	// 저장 중 할당 없음
+	Slots.SetNum(NumSlots);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 저장 / 복원
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHexapodSnapshotComponent::SaveSlot(int32 Slot)
+{
+	if (!HexapodRobot || !Slots.IsValidIndex(Slot))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HexapodSnapshot: 잘못된 슬롯 %d (0~%d)"), Slot, Slots.Num() - 1);
+		return false;
+	}
+
+	const double Start = FPlatformTime::Seconds();
+	FHexapodSnapshot& S = Slots[Slot];
+	for (int32 b = 0; b < HexapodBatchBodies; b++)
+	{
+		const UPrimitiveComponent* Body = Bodies[b];
+		S.Locations[b]         = Body->GetComponentLocation();
+		S.Rotations[b]         = Body->GetComponentQuat();
+		S.LinearVelocities[b]  = Body->GetPhysicsLinearVelocity();
+		S.AngularVelocities[b] = Body->GetPhysicsAngularVelocityInRadians();
+	}
+	FMemory::Memcpy(S.Targets, HexapodRobot->GetConstraintTargets(), sizeof(S.Targets));
+	S.GaitPhase = MovementComp ? MovementComp->GetGaitPhase() : 0.f;
+	S.Input     = MovementComp ? MovementComp->GetInputDirection() : FVector2D::ZeroVector;
+	S.SavedTime = GetWorld()->GetTimeSeconds();
+	S.bValid    = true;
+
+	SaveUs = (FPlatformTime::Seconds() - Start) * 1e6;
+	return true;
+}
+
+bool UHexapodSnapshotComponent::RestoreSlot(int32 Slot)
+{
+	if (!HexapodRobot || !IsSlotValid(Slot))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HexapodSnapshot: 슬롯 %d 이 비어 있거나 범위 밖"), Slot);
+		return false;
+	}
+
+	const double Start = FPlatformTime::Seconds();
+	const FHexapodSnapshot& S = Slots[Slot];
+
+	// 몸통(루트)부터 → 물리 시뮬레이션 중인 다리 바디는 분리되어 있으므로 각자 위치로
+	for (int32 b = 0; b < HexapodBatchBodies; b++)
+	{
+		UPrimitiveComponent* Body = Bodies[b];
+		Body->SetWorldLocationAndRotation(S.Locations[b], S.Rotations[b], false, nullptr, ETeleportType::TeleportPhysics);
+		Body->SetPhysicsLinearVelocity(S.LinearVelocities[b]);
+		Body->SetPhysicsAngularVelocityInRadians(S.AngularVelocities[b]);
+	}
+	HexapodRobot->SetConstraintTargets(S.Targets);
+
+	if (MovementComp)
+	{
+		MovementComp->SetGaitPhase(S.GaitPhase);
+		MovementComp->SetMoveForward(S.Input.X);
+		MovementComp->SetMoveRight(S.Input.Y);
+	}
+
+	// 배치 관절 각도 캐시는 복원 전 상태 기준 → 다음에 읽을 때 다시 계산
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		Batch->InvalidateRobot(HexapodRobot->GetBatchIndex());
+	// 복원은 연속된 궤적이 아님 → 기록 중인 데이터셋 에피소드를 끊음
+	if (UHexapodDatasetSubsystem* Dataset = GetWorld()->GetSubsystem<UHexapodDatasetSubsystem>())
+		Dataset->MarkEpisodeEnd(HexapodRobot);
+
+	RestoreUs = (FPlatformTime::Seconds() - Start) * 1e6;
+	return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 결정성 검사: 저장 → 행동 N 스텝 기록 → 복원 → 같은 행동 N 스텝 → 비교
+// 틱 k (PrePhysics): 스텝 k-1 의 결과 관측 기록 → 행동 k 적용
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHexapodSnapshotComponent::BeginDeterminismCheck(int32 Steps, int32 Slot)
+{
+	if (CheckPhase != ECheckPhase::Idle || !HexapodRobot) return;
+
+	// 보행 목표가 검사 행동과 섞이지 않도록 입력을 멈춘 상태로 저장 (복원 시에도 멈춘 입력)
+	if (MovementComp)
+	{
+		MovementComp->SetMoveForward(0.f);
+		MovementComp->SetMoveRight(0.f);
+	}
+
+	// 배치 PrePhysics(보행/서있는 자세 목표 반영) 뒤에 행동 적용 → 두 실행 모두 검사 행동이 최종 목표
+	if (UHexapodBatchSubsystem* Batch = GetWorld()->GetSubsystem<UHexapodBatchSubsystem>())
+		PrimaryComponentTick.AddPrerequisite(Batch, Batch->GetPrePhysicsTick());
+
+	if (!SaveSlot(Slot)) return;
+
+	CheckSlot  = Slot;
+	CheckSteps = FMath::Max(Steps, 1);
+	CheckStep  = 0;
+	CheckPhase = ECheckPhase::Record;
+
+	RecordObs.SetNumZeroed(CheckSteps * HexapodObsFields);
+	ReplayObs.SetNumZeroed(CheckSteps * HexapodObsFields);
+	RecordDelta.SetNumZeroed(CheckSteps);
+	ReplayDelta.SetNumZeroed(CheckSteps);
+
+	SetComponentTickEnabled(true);
+}
+
+// 스텝 번호만으로 정해지는 관절 목표 (서있는 자세 주변 사인파)
+void UHexapodSnapshotComponent::ApplyCheckAction(int32 Step)
+{
+	float Targets[18];
+	UHexapodMovementComponent::ComputeStandingTargets(Targets);
+	for (int32 j = 0; j < 18; j++)
+		Targets[j] += 15.f * FMath::Sin(0.05f * Step + 0.7f * j);
+	HexapodRobot->SetConstraintTargets(Targets);
+}
+
+void UHexapodSnapshotComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+                                               FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (CheckPhase == ECheckPhase::Idle || !HexapodRobot)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	const bool bRecord = CheckPhase == ECheckPhase::Record;
+	if (CheckStep > 0)
+	{
+		float* Obs = &(bRecord ? RecordObs : ReplayObs)[(CheckStep - 1) * HexapodObsFields];
+		HexapodRobot->GetObservation(Obs);
+	}
+
+	if (CheckStep == CheckSteps)
+	{
+		if (!bRecord)
+		{
+			FinishDeterminismCheck();
+			return;
+		}
+		RestoreSlot(CheckSlot);
+		CheckPhase = ECheckPhase::Replay;
+		CheckStep  = 0;
+	}
+
+	(CheckPhase == ECheckPhase::Record ? RecordDelta : ReplayDelta)[CheckStep] = DeltaTime;
+	ApplyCheckAction(CheckStep);
+	CheckStep++;
+}
+
+void UHexapodSnapshotComponent::FinishDeterminismCheck()
+{
+	CheckPhase = ECheckPhase::Idle;
+	SetComponentTickEnabled(false);
+
+	int32 IdenticalSteps = 0;
+	int32 FirstDiverged  = INDEX_NONE;
+	float MaxError       = 0.f;
+	for (int32 k = 0; k < CheckSteps; k++)
+	{
+		const float* A = &RecordObs[k * HexapodObsFields];
+		const float* B = &ReplayObs[k * HexapodObsFields];
+		if (FMemory::Memcmp(A, B, sizeof(float) * HexapodObsFields) == 0)
+		{
+			IdenticalSteps++;
+			continue;
+		}
+		if (FirstDiverged == INDEX_NONE) FirstDiverged = k;
+		for (int32 i = 0; i < HexapodObsFields; i++)
+			MaxError = FMath::Max(MaxError, FMath::Abs(A[i] - B[i]));
+	}
+
+	const bool bSameFrameTimes = FMemory::Memcmp(RecordDelta.GetData(), ReplayDelta.GetData(),
+	                                             sizeof(float) * CheckSteps) == 0;
+
+	UE_LOG(LogTemp, Log, TEXT("HexapodSnapshot[%s]: %s — 비트 일치 %d / %d 스텝, 첫 불일치 %d, 최대 오차 %g (저장 %.1f us, 복원 %.1f us)"),
+	       *GetNameSafe(HexapodRobot), IdenticalSteps == CheckSteps ? TEXT("PASS") : TEXT("FAIL"),
+	       IdenticalSteps, CheckSteps, FirstDiverged, MaxError, SaveUs, RestoreUs);
+	if (!bSameFrameTimes)
+		UE_LOG(LogTemp, Warning, TEXT("HexapodSnapshot: 두 실행의 프레임 시간이 다릅니다 — 고정 프레임으로 다시 실행하세요 (-benchmark -fps=500)."));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 콘솔 명령: Hexapod.SnapshotCheck [스텝 수] [슬롯]
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void SnapshotCheck(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World) return;
+	const int32 Steps = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+	const int32 Slot  = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+
+	for (TActorIterator<AHexapodRobot> It(World); It; ++It)
+	{
+		if (UHexapodSnapshotComponent* Snapshot = It->FindComponentByClass<UHexapodSnapshotComponent>())
+			Snapshot->BeginDeterminismCheck(Steps, Slot);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSnapshotCheckCommand(
+	TEXT("Hexapod.SnapshotCheck"),
+	TEXT("저장 → N 스텝 → 복원 → 같은 N 스텝, 관측값 비트 일치 검사. 인자: [스텝 수] [슬롯]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SnapshotCheck));
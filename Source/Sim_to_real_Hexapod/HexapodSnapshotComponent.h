@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HexapodBatchSubsystem.h"
+#include "HexapodSensorComponent.h"
+#include "HexapodSnapshotComponent.generated.h"
+
+/**
+ * 로봇 1대의 물리 상태 스냅샷.
+ * 바디 순서는 UHexapodBatchSubsystem 과 같음 (0 = 몸통, 1 + Leg * 3 + Joint)
+ */
+struct FHexapodSnapshot
+{
+	FVector Locations[HexapodBatchBodies];
+	FQuat   Rotations[HexapodBatchBodies];
+	FVector LinearVelocities[HexapodBatchBodies];    // cm/s
+	FVector AngularVelocities[HexapodBatchBodies];   // rad/s
+
+	float     Targets[18];       // 관절 드라이브 목표
+	float     GaitPhase = 0.f;
+	FVector2D Input = FVector2D::ZeroVector;
+
+	double SavedTime = 0.0;
+	bool   bValid = false;
+};
+
+/**
+ * UHexapodSnapshotComponent
+ *
+ * 미리 할당한 NumSlots 개 슬롯에 로봇 물리 상태를 저장/복원.
+ * 플래너가 한 슬롯에서 짧은 롤아웃 여러 개를 분기시키고 되돌아갈 때 사용.
+ *
+ *  저장: 19개 바디 위치/회전/선속도/각속도 + 관절 드라이브 목표 + GaitPhase/입력
+ *  복원: TeleportPhysics 로 바디를 옮기고 속도/목표를 되돌림 (PrePhysics 에서 호출해야 다음 스텝에 반영)
+ *
+ * 네트워크: "SAVE k" / "LOAD k" (UHexapodNetworkComponent). 같은 데이터그램에 "LOAD k\nJOINTS ..." 로 보내면
+ * 복원 직후 같은 물리 스텝에 행동이 적용됨.
+ *
+ * 결정성 검사 (콘솔: Hexapod.SnapshotCheck [스텝 수] [슬롯]):
+ *  슬롯 저장 → 정해진 행동 N 스텝 → 복원 → 같은 행동 N 스텝, 두 관측 열을 비트 단위 비교.
+ *  프레임 시간이 다르면 물리 결과도 다르므로 고정 프레임(-benchmark -fps=500 등)으로 실행할 것.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SIM_TO_REAL_HEXAPOD_API UHexapodSnapshotComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHexapodSnapshotComponent();
+
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+	                           FActorComponentTickFunction* ThisTickFunction) override;
+
+	bool SaveSlot(int32 Slot);
+	bool RestoreSlot(int32 Slot);
+	bool IsSlotValid(int32 Slot) const { return Slots.IsValidIndex(Slot) && Slots[Slot].bValid; }
+	int32 GetNumSlots() const { return Slots.Num(); }
+
+	/** 결정성 검사 시작 (Slot 에 현재 상태를 덮어씀). 결과는 로그로 출력 */
+	void BeginDeterminismCheck(int32 Steps, int32 Slot);
+
+	/** 슬롯 수. BeginPlay 에서 한 번 할당 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Snapshot", meta = (ClampMin = "1", ClampMax = "256"))
+	int32 NumSlots = 8;
+
+private:
+	class AHexapodRobot*             HexapodRobot = nullptr;
+	class UHexapodMovementComponent* MovementComp = nullptr;
+
+	UPrimitiveComponent* Bodies[HexapodBatchBodies] = {};
+	TArray<FHexapodSnapshot> Slots;
+
+	// ── 결정성 검사 상태 ─────────────────────────────────────
+	enum class ECheckPhase : uint8 { Idle, Record, Replay };
+	ECheckPhase CheckPhase = ECheckPhase::Idle;
+	int32 CheckSlot  = 0;
+	int32 CheckSteps = 0;
+	int32 CheckStep  = 0;
+	TArray<float> RecordObs;     // 스텝 × HexapodObsFields
+	TArray<float> ReplayObs;
+	TArray<float> RecordDelta;   // 스텝별 DeltaTime
+	TArray<float> ReplayDelta;
+	double SaveUs    = 0.0;
+	double RestoreUs = 0.0;
+
+	void ApplyCheckAction(int32 Step);
+	void FinishDeterminismCheck();
+};